@@ -0,0 +1,545 @@
+#include "crypto/base58.h"
+#include "crypto/bech32.h"
+#include "crypto/gcs.h"
+#include "crypto/hash.h"
+#include "crypto/hash_backend.h"
+#include "crypto/hex.h"
+#include "crypto/kdf.h"
+#include "crypto/merkle.h"
+#include "crypto/ripemd160_transform.h"
+#include "crypto/sha256_transform.h"
+#include "crypto/tagged_hash.h"
+#include "utils/JSONHelper.h"
+#include "utils/ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Hash throughput suite:
+//   crypto_bench [--json PATH] [--filter TEXT] [--min-time SECONDS] [--max-size BYTES]
+// Prints a table and, with --json, writes a machine-readable report for
+// comparing releases.
+
+// ---------------------------------------------------------------
+// ALLOCATION COUNTING
+// ---------------------------------------------------------------
+
+namespace {
+    std::atomic<uint64_t> allocationCount{0};
+
+    void* countedAllocate(std::size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* countedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        std::size_t align = static_cast<std::size_t>(alignment);
+        if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAllocateAligned(size, alignment); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+// ---------------------------------------------------------------
+// RUNNER
+// ---------------------------------------------------------------
+
+namespace {
+    using namespace Crypto::SHA256;
+    using Clock = std::chrono::steady_clock;
+    using json = nlohmann::json;
+
+    struct Options {
+        std::string jsonPath;
+        std::string filter;
+        double minTime = 0.2;
+        size_t maxSize = size_t(16) << 20;
+    };
+
+    struct Result {
+        std::string benchmark;
+        std::string variant;
+        size_t inputBytes;
+        size_t batch;
+        uint64_t iterations;
+        double nsPerOp;
+        double mbPerSec;
+        double allocsPerOp;
+    };
+
+    // Keeps results observable so the timed calls are not optimized away
+    volatile uint8_t sink;
+
+    class Suite {
+    public:
+        explicit Suite(const Options& options) : options(options) {}
+
+        // `op` performs one operation covering `bytesPerOp` input bytes
+        void run(const std::string& benchmark, const std::string& variant, size_t inputBytes, size_t batch,
+                 size_t bytesPerOp, const std::function<void()>& op) {
+            std::string label = benchmark + "/" + variant;
+            if (!options.filter.empty() && label.find(options.filter) == std::string::npos) {
+                return;
+            }
+
+            op();    // warm caches and lazy state (backend selection, thread pools)
+
+            uint64_t iterations = 0;
+            uint64_t batchSize = 1;
+            uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            auto start = Clock::now();
+            double elapsed = 0.0;
+            while (elapsed < options.minTime) {
+                for (uint64_t i = 0; i < batchSize; ++i) {
+                    op();
+                }
+                iterations += batchSize;
+                elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                if (elapsed < options.minTime / 10) {
+                    batchSize *= 2;
+                }
+            }
+            uint64_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+            Result result;
+            result.benchmark = benchmark;
+            result.variant = variant;
+            result.inputBytes = inputBytes;
+            result.batch = batch;
+            result.iterations = iterations;
+            result.nsPerOp = elapsed * 1e9 / iterations;
+            result.mbPerSec = static_cast<double>(bytesPerOp) * iterations / elapsed / 1e6;
+            result.allocsPerOp = static_cast<double>(allocations) / iterations;
+            results.push_back(result);
+
+            std::printf("%-12s %-18s %10zu %7zu %14.1f %11.1f %9.2f\n", benchmark.c_str(), variant.c_str(),
+                        inputBytes, batch, result.nsPerOp, result.mbPerSec, result.allocsPerOp);
+        }
+
+        void header() const {
+            std::printf("%-12s %-18s %10s %7s %14s %11s %9s\n", "benchmark", "variant", "bytes", "batch",
+                        "ns/op", "MB/s", "allocs/op");
+        }
+
+        json report() const {
+            json entries = json::array();
+            for (const Result& r : results) {
+                entries.push_back({{"benchmark", r.benchmark},
+                                   {"variant", r.variant},
+                                   {"inputBytes", r.inputBytes},
+                                   {"batch", r.batch},
+                                   {"iterations", r.iterations},
+                                   {"nsPerOp", r.nsPerOp},
+                                   {"mbPerSec", r.mbPerSec},
+                                   {"allocsPerOp", r.allocsPerOp}});
+            }
+            return {{"schemaVersion", 1},
+                    {"timestamp", Crypto::Utils::JSONHelper::getCurrentTimestamp()},
+                    {"environment",
+                     {{"hashBackend", HashBackendRegistry::active().name()},
+                      {"ripemd160Backend", HashBackendRegistry::activeRipemd160().name()},
+                      {"sha256Kernel", Transform::implementationName(Transform::active())},
+                      {"sha256Lanes", Transform::laneWidth()},
+                      {"ripemd160Lanes", Ripemd160Transform::laneWidth()},
+                      {"threads", Crypto::Utils::ThreadPool::configuredThreadCount()},
+                      {"minTimeSeconds", options.minTime}}},
+                    {"results", entries}};
+        }
+
+    private:
+        const Options& options;
+        std::vector<Result> results;
+    };
+
+    std::vector<uint8_t> randomBytes(size_t count, uint64_t seed) {
+        std::vector<uint8_t> bytes(count);
+        std::mt19937_64 rng(seed);
+        for (auto& byte : bytes) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        return bytes;
+    }
+
+    std::vector<size_t> inputSizes(const Options& options) {
+        std::vector<size_t> sizes;
+        for (size_t size : {size_t(32), size_t(64), size_t(256), size_t(1) << 10, size_t(4) << 10,
+                            size_t(64) << 10, size_t(1) << 20, size_t(16) << 20}) {
+            if (size <= options.maxSize) {
+                sizes.push_back(size);
+            }
+        }
+        return sizes;
+    }
+
+    // ---------------------------------------------------------------
+    // CASES
+    // ---------------------------------------------------------------
+
+    void benchSingleShot(Suite& suite, const Options& options) {
+        for (size_t size : inputSizes(options)) {
+            std::vector<uint8_t> input = randomBytes(size, size);
+            const uint8_t* data = input.data();
+
+            suite.run("sha256", "raw", size, 1, size, [&]() { sink = Hash::sha256Raw(data, size)[0]; });
+            suite.run("sha256d", "raw", size, 1, size, [&]() { sink = Hash::sha256dRaw(data, size)[0]; });
+            suite.run("ripemd160", "raw", size, 1, size, [&]() { sink = Hash::ripemd160Raw(data, size)[0]; });
+            suite.run("hash160", "raw", size, 1, size, [&]() { sink = Hash::hash160Raw(data, size)[0]; });
+        }
+    }
+
+    void benchTagged(Suite& suite) {
+        for (size_t size : {size_t(32), size_t(64), size_t(256)}) {
+            std::vector<uint8_t> message = randomBytes(size, size + 3);
+            const std::string tag = "BIP0340/challenge";
+            suite.run("taggedHash", "constexpr", size, 1, size, [&]() {
+                sink = Hash::taggedHash(Tags::BIP340_CHALLENGE, message)[0];
+            });
+            suite.run("taggedHash", "string", size, 1, size, [&]() {
+                sink = Hash::taggedHash(tag, message)[0];
+            });
+        }
+    }
+
+    // BIP39 seed derivation cost: PBKDF2-HMAC-SHA512, 2048 iterations, 64-byte output
+    void benchKdf(Suite& suite) {
+        const uint32_t iterations = 2048;
+        std::vector<uint8_t> password = randomBytes(48, 7);
+        std::vector<uint8_t> salt = randomBytes(16, 8);
+        for (size_t batch : {size_t(1), size_t(8)}) {
+            std::vector<uint8_t> keys(64 * batch);
+            std::vector<Pbkdf2Request> requests;
+            for (size_t i = 0; i < batch; ++i) {
+                requests.push_back({password, salt, iterations, keys.data() + 64 * i, 64});
+            }
+            suite.run("pbkdf2", "sha512-2048", password.size(), batch, 0, [&]() {
+                Kdf::pbkdf2Sha512Batch(requests.data(), batch);
+                sink = keys[0];
+            });
+            for (auto& request : requests) {
+                request.outputLength = 32;
+            }
+            suite.run("pbkdf2", "sha256-2048", password.size(), batch, 0, [&]() {
+                Kdf::pbkdf2Sha256Batch(requests.data(), batch);
+                sink = keys[0];
+            });
+        }
+    }
+
+    void benchBatches(Suite& suite) {
+        for (size_t batch : {size_t(1), size_t(8), size_t(64), size_t(1024), size_t(16384)}) {
+            // 64-byte messages (two blocks after padding) for the SHA-256 lanes
+            std::vector<uint8_t> messages = randomBytes(64 * batch, batch);
+            std::vector<ByteView> views;
+            for (size_t i = 0; i < batch; ++i) {
+                views.emplace_back(messages.data() + 64 * i, 64);
+            }
+            std::vector<Digest256> digests(batch);
+            suite.run("sha256", "batch", 64, batch, 64 * batch, [&]() {
+                Hash::sha256Batch(views.data(), digests.data(), batch);
+                sink = digests[0][0];
+            });
+            suite.run("sha256d", "batch", 64, batch, 64 * batch, [&]() {
+                Hash::sha256dBatch(views.data(), digests.data(), batch);
+                sink = digests[0][0];
+            });
+
+            // 33-byte compressed public keys for address derivation
+            std::vector<uint8_t> keys = randomBytes(33 * batch, batch + 1);
+            std::vector<Digest160> addresses(batch);
+            suite.run("hash160", "batch", 33, batch, 33 * batch, [&]() {
+                Hash::hash160Batch(keys.data(), 33, batch, addresses.data());
+                sink = addresses[0][0];
+            });
+        }
+    }
+
+    void benchMerkle(Suite& suite) {
+        for (size_t leaves : {size_t(2), size_t(16), size_t(256), size_t(4096), size_t(65536)}) {
+            std::vector<Digest256> digests(leaves);
+            std::vector<uint8_t> bytes = randomBytes(32 * leaves, leaves);
+            for (size_t i = 0; i < leaves; ++i) {
+                std::copy(bytes.begin() + 32 * i, bytes.begin() + 32 * (i + 1), digests[i].begin());
+            }
+            suite.run("merkleRoot", "binary", 32, leaves, 32 * leaves, [&]() {
+                sink = Hash::merkleRoot(digests)[0];
+            });
+
+            std::vector<std::string> hexLeaves;
+            for (const Digest256& digest : digests) {
+                hexLeaves.push_back(digest.toHex());
+            }
+            suite.run("merkleRoot", "legacy-hex", 64, leaves, 64 * leaves, [&]() {
+                sink = static_cast<uint8_t>(MerkleEngine::shared().root(hexLeaves, MerkleMode::LEGACY_HEX)[0]);
+            });
+        }
+    }
+
+    void benchHex(Suite& suite, const Options& options) {
+        for (size_t size : inputSizes(options)) {
+            std::vector<uint8_t> bytes = randomBytes(size, size + 2);
+            std::string text(2 * size, '\0');
+            Hex::encode(bytes.data(), size, &text[0]);
+            std::vector<uint8_t> decoded(size);
+
+            suite.run("hex", "encode", size, 1, size, [&]() {
+                Hex::encode(bytes.data(), size, &text[0]);
+                sink = static_cast<uint8_t>(text[0]);
+            });
+            suite.run("hex", "decode", 2 * size, 1, 2 * size, [&]() {
+                sink = Hex::decode(text.data(), text.size(), decoded.data()).ok;
+            });
+            suite.run("hex", "bytesToHex", size, 1, size, [&]() {
+                sink = static_cast<uint8_t>(Hash::bytesToHex(bytes)[0]);
+            });
+            suite.run("hex", "hexToBytes", 2 * size, 1, 2 * size, [&]() {
+                sink = Hash::hexToBytes(text)[0];
+            });
+        }
+    }
+
+    // BIP158 basic filter for a block with 10k scripts: build, single lookups and a 100-script watch list
+    void benchBlockFilter(Suite& suite) {
+        const size_t elements = 10000;
+        std::vector<uint8_t> scripts = randomBytes(25 * elements, 11);
+        std::vector<ByteView> views;
+        for (size_t i = 0; i < elements; ++i) {
+            views.emplace_back(scripts.data() + 25 * i, 25);
+        }
+        Digest256 blockHash = Hash::sha256Raw(scripts.data(), 80);
+
+        suite.run("gcs", "build", 25, elements, 25 * elements, [&]() {
+            sink = BlockFilter::build(blockHash, views).encoded()[0];
+        });
+
+        GolombCodedSet filter = BlockFilter::build(blockHash, views);
+        std::vector<uint8_t> misses = randomBytes(25 * 100, 12);
+        std::vector<ByteView> watchList;
+        for (size_t i = 0; i < 100; ++i) {
+            watchList.emplace_back(misses.data() + 25 * i, 25);
+        }
+        suite.run("gcs", "match-one", 25, 1, 25, [&]() {
+            sink = filter.match(watchList[0]);
+        });
+        suite.run("gcs", "match-any-100", 25, 100, 25 * 100, [&]() {
+            sink = filter.matchAny(watchList);
+        });
+        suite.run("gcs", "match-100-singly", 25, 100, 25 * 100, [&]() {
+            bool hit = false;
+            for (const ByteView& script : watchList) {
+                hit |= filter.match(script);
+            }
+            sink = hit;
+        });
+    }
+
+    // Textbook Base58: one base-256 digit folded in per step, one byte of carry per digit
+    std::string naiveBase58(const uint8_t* data, size_t length) {
+        static const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+        size_t zeros = 0;
+        while (zeros < length && data[zeros] == 0) {
+            ++zeros;
+        }
+        std::vector<uint8_t> digits(length * 138 / 100 + 1);
+        size_t used = 0;
+        for (size_t i = zeros; i < length; ++i) {
+            int carry = data[i];
+            size_t j = 0;
+            for (auto it = digits.rbegin(); (carry != 0 || j < used) && it != digits.rend(); ++it, ++j) {
+                carry += 256 * (*it);
+                *it = static_cast<uint8_t>(carry % 58);
+                carry /= 58;
+            }
+            used = j;
+        }
+        std::string out(zeros, '1');
+        for (size_t i = digits.size() - used; i < digits.size(); ++i) {
+            out += alphabet[digits[i]];
+        }
+        return out;
+    }
+
+    void benchAddresses(Suite& suite) {
+        for (size_t batch : {size_t(1), size_t(1024), size_t(16384)}) {
+            std::vector<uint8_t> bytes = randomBytes(20 * batch, batch + 5);
+            std::vector<Digest160> hashes(batch);
+            for (size_t i = 0; i < batch; ++i) {
+                std::copy(bytes.begin() + 20 * i, bytes.begin() + 20 * (i + 1), hashes[i].begin());
+            }
+
+            suite.run("base58check", "naive", 25, batch, 25 * batch, [&]() {
+                uint8_t raw[25];
+                for (size_t i = 0; i < batch; ++i) {
+                    raw[0] = 0x00;
+                    std::copy(hashes[i].begin(), hashes[i].end(), raw + 1);
+                    Digest256 checksum = Hash::sha256dRaw(raw, 21);
+                    std::copy(checksum.begin(), checksum.begin() + 4, raw + 21);
+                    sink = static_cast<uint8_t>(naiveBase58(raw, 25)[0]);
+                }
+            });
+            suite.run("base58check", "limbs", 25, batch, 25 * batch, [&]() {
+                for (size_t i = 0; i < batch; ++i) {
+                    sink = static_cast<uint8_t>(Base58::encodeAddress(0x00, hashes[i])[0]);
+                }
+            });
+            suite.run("base58check", "batch", 25, batch, 25 * batch, [&]() {
+                sink = static_cast<uint8_t>(Base58::encodeAddressBatch(0x00, hashes.data(), batch)[0][0]);
+            });
+            std::vector<char> slots(Base58::ADDRESS_TEXT_SIZE * batch);
+            auto* out = reinterpret_cast<char (*)[Base58::ADDRESS_TEXT_SIZE]>(slots.data());
+            suite.run("base58check", "batch-slots", 25, batch, 25 * batch, [&]() {
+                Base58::encodeAddressBatch(0x00, hashes.data(), batch, out);
+                sink = static_cast<uint8_t>(out[0][0]);
+            });
+            suite.run("bech32", "single", 20, batch, 20 * batch, [&]() {
+                for (size_t i = 0; i < batch; ++i) {
+                    sink = static_cast<uint8_t>(Bech32::encodeSegwit("bc", 0, hashes[i])[4]);
+                }
+            });
+            suite.run("bech32", "batch", 20, batch, 20 * batch, [&]() {
+                sink = static_cast<uint8_t>(Bech32::encodeSegwitBatch("bc", 0, hashes.data(), batch)[0][4]);
+            });
+        }
+    }
+
+    // Large block document: header plus `count` transactions with inputs and outputs
+    json blockDocument(size_t count) {
+        json transactions = json::array();
+        for (size_t i = 0; i < count; ++i) {
+            std::string id = Hash::bytesToHex(randomBytes(32, i));
+            transactions.push_back({{"txid", id},
+                                    {"inputs", {{{"prevout", id}, {"index", i % 4}, {"sequence", 0xffffffffu}}}},
+                                    {"outputs", {{{"value", 5000 + i}, {"script", id.substr(0, 50)}},
+                                                 {{"value", 100 + i}, {"script", id.substr(14, 50)}}}}});
+        }
+        return {{"block",
+                 {{"header", {{"height", 840000}, {"nonce", 2596996162u}, {"hash", Hash::bytesToHex(randomBytes(32, 1))}}},
+                  {"transactions", transactions}}}};
+    }
+
+    // The copying walk JSONHelper used to do: every level deep-copies the remaining subtree
+    json copyingWalk(const json& root, const std::vector<std::string>& parts) {
+        json current = root;
+        for (const auto& part : parts) {
+            if (!current.contains(part)) return nullptr;
+            current = current[part];
+        }
+        return current;
+    }
+
+    void benchJSONPaths(Suite& suite) {
+        using Crypto::Utils::JSONHelper;
+        using Crypto::Utils::JSONPath;
+        for (size_t count : {size_t(100), size_t(10000)}) {
+            json document = blockDocument(count);
+            size_t bytes = document.dump().size();
+            const std::string dotted = "block.header.nonce";
+            const JSONPath compiled(dotted);
+            const std::vector<std::string> parts = compiled.segments();
+
+            suite.run("jsonPath", "copying-walk", bytes, 1, 0, [&]() {
+                sink = static_cast<uint8_t>(copyingWalk(document, parts).get<uint32_t>());
+            });
+            suite.run("jsonPath", "getNestedValue", bytes, 1, 0, [&]() {
+                sink = static_cast<uint8_t>(JSONHelper::getNestedValue(document, dotted).get<uint32_t>());
+            });
+            suite.run("jsonPath", "findNested-string", bytes, 1, 0, [&]() {
+                sink = static_cast<uint8_t>(JSONHelper::findNested(document, dotted)->get<uint32_t>());
+            });
+            suite.run("jsonPath", "compiled", bytes, 1, 0, [&]() {
+                sink = static_cast<uint8_t>(compiled.find(document)->get<uint32_t>());
+            });
+            suite.run("jsonPath", "getNested<uint32>", bytes, 1, 0, [&]() {
+                sink = static_cast<uint8_t>(JSONHelper::getNested<uint32_t>(document, compiled));
+            });
+            suite.run("jsonPath", "json_pointer-at", bytes, 1, 0, [&]() {
+                sink = static_cast<uint8_t>(document.at(compiled.pointer()).get<uint32_t>());
+            });
+
+            // Deep lookup into the transaction array
+            const JSONPath deep("block.transactions." + std::to_string(count / 2) + ".outputs.1.value");
+            suite.run("jsonPath", "deep-compiled", bytes, 1, 0, [&]() {
+                sink = static_cast<uint8_t>(JSONHelper::getNested<uint64_t>(document, deep));
+            });
+        }
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                return false;
+            }
+            if (arg == "--json") {
+                options.jsonPath = argv[++i];
+            } else if (arg == "--filter") {
+                options.filter = argv[++i];
+            } else if (arg == "--min-time") {
+                options.minTime = std::atof(argv[++i]);
+            } else if (arg == "--max-size") {
+                options.maxSize = std::strtoull(argv[++i], nullptr, 10);
+            } else {
+                return false;
+            }
+        }
+        return options.minTime > 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--json PATH] [--filter TEXT] [--min-time SECONDS] [--max-size BYTES]\n", argv[0]);
+        return 2;
+    }
+
+    HashBackendRegistry::initialize();
+
+    Suite suite(options);
+    suite.header();
+    benchSingleShot(suite, options);
+    benchTagged(suite);
+    benchBatches(suite);
+    benchKdf(suite);
+    benchMerkle(suite);
+    benchHex(suite, options);
+    benchAddresses(suite);
+    benchBlockFilter(suite);
+    benchJSONPaths(suite);
+
+    if (!options.jsonPath.empty()) {
+        Crypto::Utils::JSONHelper::saveToFile(suite.report(), options.jsonPath);
+        std::printf("Report written to %s\n", options.jsonPath.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "crypto/hash.h"
+#include "crypto/hash160.h"
+#include "crypto/hash_backend.h"
+#include "crypto/ripemd160_transform.h"
+#include "crypto/sha256_transform.h"
+#include "utils/ThreadPool.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Hash160 throughput over packed 33-byte compressed public keys:
+//   hash160_bench [keyCount] [maxThreads]
+int main(int argc, char** argv) {
+    using namespace Crypto::SHA256;
+    using Clock = std::chrono::steady_clock;
+
+    const size_t keyCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const size_t maxThreads = argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                                       : Crypto::Utils::ThreadPool::configuredThreadCount();
+    const size_t keySize = 33;
+
+    std::vector<uint8_t> keys(keyCount * keySize);
+    std::mt19937_64 rng(42);
+    for (auto& byte : keys) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    std::vector<Digest160> reference(keyCount);
+    std::vector<Digest160> outputs(keyCount);
+
+    auto report = [keyCount](const std::string& label, Clock::duration elapsed) {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        std::printf("%-28s %10.3f ms %14.0f keys/s %8.1f ns/key\n", label.c_str(), seconds * 1e3,
+                    keyCount / seconds, seconds * 1e9 / keyCount);
+    };
+
+    HashBackendRegistry::initialize();
+    std::printf("Hash160 over %zu x %zu-byte keys (SHA-256 kernel %s, RIPEMD-160 lanes %zu)\n", keyCount, keySize,
+                Transform::implementationName(Transform::active()), Ripemd160Transform::laneWidth());
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < keyCount; ++i) {
+        reference[i] = Hash::hash160Raw(keys.data() + i * keySize, keySize);
+    }
+    report("hash160Raw (one at a time)", Clock::now() - start);
+
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        Hash160Engine engine(threads);
+        start = Clock::now();
+        engine.hash(keys.data(), keySize, keyCount, outputs.data());
+        report("batch, " + std::to_string(threads) + " thread(s)", Clock::now() - start);
+
+        if (outputs != reference) {
+            std::fprintf(stderr, "Batch output differs from hash160Raw\n");
+            return 1;
+        }
+    }
+    return 0;
+}
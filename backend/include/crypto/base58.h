@@ -0,0 +1,48 @@
+#ifndef BASE58_H
+#define BASE58_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // BASE58 / BASE58CHECK (BITCOIN ALPHABET)
+        // The big-number conversion works on 32-bit limbs: base 2^32 words on the
+        // binary side and base 58^5 limbs on the text side, so each inner step
+        // moves 4 bytes or 5 digits and the quadratic term shrinks ~20x against
+        // byte-at-a-time division. Buffers for address-sized inputs stay on the stack.
+        class Base58 {
+        public:
+            // Upper bound on the encoded length of `length` bytes (log(256) / log(58) < 1.37)
+            static constexpr size_t maxEncodedLength(size_t length) { return length * 137 / 100 + 1; }
+
+            // `out` must hold maxEncodedLength(data.size()) chars; returns the number written
+            static size_t encode(ByteView data, char* out);
+            static std::string encode(ByteView data);
+            // Throws std::invalid_argument on characters outside the alphabet
+            static std::vector<uint8_t> decode(const std::string& text);
+
+            // BASE58CHECK: PAYLOAD || FIRST 4 BYTES OF sha256d(PAYLOAD)
+            static std::string encodeCheck(ByteView payload);
+            // Throws std::invalid_argument on bad characters, short input or checksum mismatch
+            static std::vector<uint8_t> decodeCheck(const std::string& text);
+
+            // LEGACY ADDRESSES: VERSION BYTE || HASH160 (0x00 = P2PKH, 0x05 = P2SH ON MAINNET)
+            // Slot size for one NUL-terminated address: maxEncodedLength(25) chars plus the terminator
+            static constexpr size_t ADDRESS_TEXT_SIZE = 36;
+
+            static std::string encodeAddress(uint8_t version, const Digest160& hash);
+            // Checksums go through the SHA-256d lane kernels in stack-sized chunks; the
+            // slot overload writes `count` NUL-terminated addresses without allocating
+            static void encodeAddressBatch(uint8_t version, const Digest160* hashes, size_t count, char (*out)[ADDRESS_TEXT_SIZE]);
+            static std::vector<std::string> encodeAddressBatch(uint8_t version, const Digest160* hashes, size_t count);
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
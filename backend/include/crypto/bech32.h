@@ -0,0 +1,55 @@
+#ifndef BECH32_H
+#define BECH32_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // BECH32 (BIP173) / BECH32M (BIP350) AND SEGWIT ADDRESSES
+        // The BCH checksum runs one table lookup per character. Batch encoders
+        // fold the human-readable part into the checksum state once and resume
+        // from it for every address, writing into a fixed stack buffer.
+        class Bech32 {
+        public:
+            enum class Encoding {
+                BECH32,
+                BECH32M
+            };
+
+            struct Decoded {
+                Encoding encoding;
+                std::string hrp;
+                std::vector<uint8_t> values;    // 5-bit groups, checksum removed
+            };
+
+            struct SegwitProgram {
+                int version;
+                std::vector<uint8_t> program;
+            };
+
+            // Longest string either standard allows
+            static constexpr size_t MAX_LENGTH = 90;
+
+            // `values` are 5-bit groups; throws std::invalid_argument for a bad hrp or overlong result
+            static std::string encode(const std::string& hrp, const uint8_t* values, size_t count, Encoding encoding);
+            // Throws std::invalid_argument on mixed case, bad characters or a failed checksum
+            static Decoded decode(const std::string& text);
+
+            // Witness version 0 uses Bech32, versions 1-16 use Bech32m
+            static std::string encodeSegwit(const std::string& hrp, int version, ByteView program);
+            static SegwitProgram decodeSegwit(const std::string& hrp, const std::string& address);
+
+            // P2WPKH (20-byte) and P2WSH / P2TR (32-byte) programs in bulk
+            static std::vector<std::string> encodeSegwitBatch(const std::string& hrp, int version, const Digest160* programs, size_t count);
+            static std::vector<std::string> encodeSegwitBatch(const std::string& hrp, int version, const Digest256* programs, size_t count);
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
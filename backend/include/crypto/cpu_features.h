@@ -0,0 +1,21 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // RUNTIME CPU FEATURE PROBE (CPUID + XGETBV ON x86, ALL FALSE ELSEWHERE)
+        struct CpuFeatures {
+            bool ssse3 = false;
+            bool sse41 = false;
+            bool avx2 = false;
+            bool shaNi = false;
+
+            // Probed once on first use
+            static const CpuFeatures& get();
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef DIGEST_H
+#define DIGEST_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "crypto/hex.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // NON-OWNING VIEW OVER CONTIGUOUS BYTES (C++17 STAND-IN FOR std::span<const uint8_t>)
+        class ByteView {
+        public:
+            constexpr ByteView() noexcept : ptr(nullptr), len(0) {}
+            constexpr ByteView(const uint8_t* data, size_t size) noexcept : ptr(data), len(size) {}
+
+            ByteView(const std::vector<uint8_t>& bytes) noexcept
+                : ptr(bytes.data()), len(bytes.size()) {}
+
+            ByteView(const std::string& text) noexcept
+                : ptr(reinterpret_cast<const uint8_t*>(text.data())), len(text.size()) {}
+
+            template <size_t N>
+            constexpr ByteView(const std::array<uint8_t, N>& bytes) noexcept
+                : ptr(bytes.data()), len(N) {}
+
+            constexpr const uint8_t* data() const noexcept { return ptr; }
+            constexpr size_t size() const noexcept { return len; }
+            constexpr bool empty() const noexcept { return len == 0; }
+
+            constexpr const uint8_t* begin() const noexcept { return ptr; }
+            constexpr const uint8_t* end() const noexcept { return ptr + len; }
+            constexpr uint8_t operator[](size_t i) const noexcept { return ptr[i]; }
+
+        private:
+            const uint8_t* ptr;
+            size_t len;
+        };
+
+        // FIXED-SIZE DIGEST VALUE TYPE
+        template <size_t N>
+        struct Digest {
+            static constexpr size_t SIZE = N;
+
+            std::array<uint8_t, N> bytes{};
+
+            uint8_t* data() noexcept { return bytes.data(); }
+            const uint8_t* data() const noexcept { return bytes.data(); }
+            static constexpr size_t size() noexcept { return N; }
+
+            uint8_t* begin() noexcept { return bytes.data(); }
+            uint8_t* end() noexcept { return bytes.data() + N; }
+            const uint8_t* begin() const noexcept { return bytes.data(); }
+            const uint8_t* end() const noexcept { return bytes.data() + N; }
+
+            uint8_t& operator[](size_t i) noexcept { return bytes[i]; }
+            uint8_t operator[](size_t i) const noexcept { return bytes[i]; }
+
+            operator ByteView() const noexcept { return ByteView(bytes.data(), N); }
+
+            std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(bytes.begin(), bytes.end()); }
+
+            // Hex encoding belongs at the display boundary only
+            std::string toHex() const { return Hex::encode(bytes.data(), N); }
+
+            friend bool operator==(const Digest& a, const Digest& b) noexcept {
+                return std::memcmp(a.bytes.data(), b.bytes.data(), N) == 0;
+            }
+            friend bool operator!=(const Digest& a, const Digest& b) noexcept { return !(a == b); }
+            friend bool operator<(const Digest& a, const Digest& b) noexcept {
+                return std::memcmp(a.bytes.data(), b.bytes.data(), N) < 0;
+            }
+        };
+
+        using Digest512 = Digest<64>;
+        using Digest256 = Digest<32>;
+        using Digest160 = Digest<20>;
+
+    } // namespace SHA256
+} // namespace Crypto
+
+namespace std {
+    // Digest bytes are already uniformly distributed, so the leading word is a good bucket key
+    template <size_t N>
+    struct hash<Crypto::SHA256::Digest<N>> {
+        size_t operator()(const Crypto::SHA256::Digest<N>& digest) const noexcept {
+            size_t h = 0;
+            std::memcpy(&h, digest.data(), N < sizeof(h) ? N : sizeof(h));
+            return h;
+        }
+    };
+}
+
+#endif
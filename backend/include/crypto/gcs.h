@@ -0,0 +1,112 @@
+#ifndef GCS_H
+#define GCS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // MSB-FIRST BIT STREAMS FOR GOLOMB-RICE CODES
+        class BitStreamWriter {
+        public:
+            explicit BitStreamWriter(std::vector<uint8_t>& out) : out(out) {}
+
+            // Low `count` bits of `value`, most significant first (count <= 64)
+            void write(uint64_t value, int count);
+            // `count` one bits followed by a zero
+            void writeUnary(uint64_t count);
+            // Pads the final byte with zero bits
+            void flush();
+
+        private:
+            std::vector<uint8_t>& out;
+            uint64_t accumulator = 0;
+            int pending = 0;
+        };
+
+        class BitStreamReader {
+        public:
+            BitStreamReader(const uint8_t* data, size_t length) : data(data), length(length) {}
+
+            // Throws std::out_of_range when the stream runs dry
+            uint64_t read(int count);
+            uint64_t readUnary();
+            // Unary quotient then a `p`-bit remainder
+            uint64_t readGolombRice(int p);
+
+        private:
+            void refill();
+            void consume(int count);
+
+            const uint8_t* data;
+            size_t length;
+            size_t position = 0;
+            uint64_t buffer = 0;    // unread bits, left-aligned
+            int available = 0;
+        };
+
+        // GOLOMB-CODED SET (BIP158)
+        // Elements are SipHash-ed and mapped into [0, N * M), sorted, and stored as
+        // Golomb-Rice coded deltas after a CompactSize element count. Membership
+        // tests decode the stream once; batch queries are hashed, sorted and merged
+        // against it so a whole watch list costs one pass.
+        class GolombCodedSet {
+        public:
+            struct Params {
+                uint64_t k0 = 0;
+                uint64_t k1 = 0;
+                int p = 19;
+                uint32_t m = 784931;
+            };
+
+            // Builds from `count` elements; duplicates are dropped
+            GolombCodedSet(const Params& params, const ByteView* elements, size_t count);
+            GolombCodedSet(const Params& params, const std::vector<ByteView>& elements);
+            // Wraps a serialized set; throws std::invalid_argument on a malformed count
+            GolombCodedSet(const Params& params, std::vector<uint8_t> encoded);
+
+            const std::vector<uint8_t>& encoded() const { return bytes; }
+            uint64_t size() const { return count; }
+
+            bool match(ByteView element) const;
+            bool matchAny(const ByteView* elements, size_t count) const;
+            bool matchAny(const std::vector<ByteView>& elements) const;
+
+            // Every value in [0, N * M) in ascending order (diagnostics and tests)
+            std::vector<uint64_t> decode() const;
+
+        private:
+            uint64_t range() const { return count * params.m; }
+            std::vector<uint64_t> hashQueries(const ByteView* elements, size_t count) const;
+            bool matchSorted(const std::vector<uint64_t>& queries) const;
+
+            Params params;
+            uint64_t count = 0;
+            size_t headerSize = 0;    // CompactSize prefix
+            std::vector<uint8_t> bytes;
+        };
+
+        // BIP158 BASIC BLOCK FILTER: P = 19, M = 784931, KEYED BY THE BLOCK HASH
+        class BlockFilter {
+        public:
+            static constexpr int BASIC_P = 19;
+            static constexpr uint32_t BASIC_M = 784931;
+
+            // SipHash key: first 16 bytes of the block hash (internal byte order)
+            static GolombCodedSet::Params basicParams(const Digest256& blockHash);
+
+            // `scripts` are the output scriptPubKeys and spent prevout scripts of the block
+            static GolombCodedSet build(const Digest256& blockHash, const std::vector<ByteView>& scripts);
+            static GolombCodedSet parse(const Digest256& blockHash, std::vector<uint8_t> encoded);
+
+            // Filter header chain: sha256d(sha256d(filter) || previous header)
+            static Digest256 header(const std::vector<uint8_t>& encoded, const Digest256& previousHeader);
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
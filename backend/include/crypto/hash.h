@@ -5,9 +5,18 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#include "crypto/digest.h"
 
 namespace Crypto {
     namespace SHA256 {
+        enum class HashAlgorithm {
+            SHA256,
+            SHA256D,
+            RIPEMD160
+        };
+
+        class TaggedHash;
+
         class Hash {
         public:
             Hash();
@@ -26,19 +35,63 @@ namespace Crypto {
             
             // Hash160 (SHA-256 + RIPEMD-160) - Used for addresses
             static std::string hash160(const std::string& data);
+            static std::string hash160(const std::vector<uint8_t>& data);
+
+            // RAW FIXED-SIZE DIGESTS (NO HEAP ALLOCATION, NO LOGGING)
+            static Digest256 sha256Raw(const uint8_t* data, size_t length);
+            static Digest256 sha256Raw(ByteView data);
+            static Digest256 sha256dRaw(const uint8_t* data, size_t length);
+            static Digest256 sha256dRaw(ByteView data);
+            static Digest160 ripemd160Raw(const uint8_t* data, size_t length);
+            static Digest160 ripemd160Raw(ByteView data);
+            static Digest160 hash160Raw(const uint8_t* data, size_t length);
+            static Digest160 hash160Raw(ByteView data);
+
+            // BATCH HASHING (INDEPENDENT INPUTS SPREAD ACROSS SIMD LANES)
+            static void sha256Batch(const ByteView* inputs, Digest256* outputs, size_t count);
+            static void sha256dBatch(const ByteView* inputs, Digest256* outputs, size_t count);
+            static std::vector<Digest256> sha256Batch(const std::vector<ByteView>& inputs);
+            static std::vector<Digest256> sha256dBatch(const std::vector<ByteView>& inputs);
+
+            // BATCH HASH160 (SHA-256 LANES FEEDING RIPEMD-160 LANES, THREADED FOR LARGE BATCHES)
+            static void hash160Batch(const ByteView* inputs, Digest160* outputs, size_t count);
+            static void hash160Batch(const uint8_t* inputs, size_t inputSize, size_t count, Digest160* outputs);
+            static std::vector<Digest160> hash160Batch(const std::vector<ByteView>& inputs);
+
+            // BIP340 TAGGED HASHES: SHA256(SHA256(tag) || SHA256(tag) || msg)
+            // Prefer a constexpr TaggedHash (see crypto/tagged_hash.h); string tags
+            // have their prefix midstate cached per thread after first use.
+            static Digest256 taggedHash(const TaggedHash& tag, ByteView message);
+            static Digest256 taggedHash(const std::string& tag, ByteView message);
+
+            // KEYED HASHING AND KEY DERIVATION (SEE crypto/hmac.h AND crypto/kdf.h FOR REUSABLE KEYS AND BATCHES)
+            static Digest256 hmacSha256(ByteView key, ByteView message);
+            static Digest512 hmacSha512(ByteView key, ByteView message);
+            static std::vector<uint8_t> pbkdf2Sha256(ByteView password, ByteView salt, uint32_t iterations, size_t length);
+            static std::vector<uint8_t> pbkdf2Sha512(ByteView password, ByteView salt, uint32_t iterations, size_t length);
+            static std::vector<uint8_t> hkdfSha256(ByteView inputKey, ByteView salt, ByteView info, size_t length);
+
+            // COMPACT BLOCK FILTERS (BIP158 BASIC GCS; SEE crypto/gcs.h TO KEEP A PARSED FILTER AROUND)
+            static std::vector<uint8_t> blockFilter(const Digest256& blockHash, const std::vector<ByteView>& scripts);
+            static bool blockFilterMatchAny(const Digest256& blockHash, const std::vector<uint8_t>& filter,
+                                            const std::vector<ByteView>& scripts);
+            static Digest256 blockFilterHeader(const std::vector<uint8_t>& filter, const Digest256& previousHeader);
+
+            // STREAMING FILE HASHING (mmap WINDOWS, FLAT MEMORY REGARDLESS OF FILE SIZE)
+            static std::string hashFile(const std::string& filePath, HashAlgorithm algorithm = HashAlgorithm::SHA256);
+            static Digest256 sha256File(const std::string& filePath);
+            static Digest256 sha256dFile(const std::string& filePath);
+            static Digest160 ripemd160File(const std::string& filePath);
             
             // MERKLE TREE FOR ROOT HASH
             static std::string merkleRoot(const std::vector<std::string>& hashes);
+            static Digest256 merkleRoot(const std::vector<Digest256>& leaves);
             
             // UTILS
             static std::string bytesToHex(const std::vector<uint8_t>& bytes);
             static std::vector<uint8_t> hexToBytes(const std::string& hex);
 
             ~Hash();
-        private:
-            static std::vector<uint8_t> sha256Raw(const std::vector<uint8_t>& data);
-            static std::vector<uint8_t> ripemd160Raw(const std::vector<uint8_t>& data);
-
         };
     } // namespace SHA256
 } // namespace Crypto
@@ -0,0 +1,55 @@
+#ifndef HASH160_H
+#define HASH160_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace Utils {
+        class ThreadPool;
+    }
+
+    namespace SHA256 {
+
+        // BATCH HASH160 (RIPEMD-160 OF SHA-256) PIPELINE
+        // Inputs are processed in fixed chunks: the SHA-256 batch kernels write
+        // each chunk's digests into a stack buffer that the multi-lane RIPEMD-160
+        // kernel consumes directly. Large batches are split across a thread pool.
+        class Hash160Engine {
+        public:
+            // threadCount == 0 takes `mining.threadCount` from the config
+            explicit Hash160Engine(size_t threadCount = 0);
+            ~Hash160Engine();
+
+            Hash160Engine(const Hash160Engine&) = delete;
+            Hash160Engine& operator=(const Hash160Engine&) = delete;
+
+            // Independent inputs of any length
+            void hash(const ByteView* inputs, Digest160* outputs, size_t count) const;
+
+            // `count` fixed-size records packed back to back (e.g. 33-byte compressed public keys)
+            void hash(const uint8_t* inputs, size_t inputSize, size_t count, Digest160* outputs) const;
+
+            size_t threadCount() const;
+
+            // Shared engine sized from the config on first use
+            static const Hash160Engine& shared();
+
+            // Inputs per SHA-256 -> RIPEMD-160 hand-off
+            static constexpr size_t CHUNK_SIZE = 256;
+            // Batches smaller than this are hashed on the calling thread
+            static constexpr size_t PARALLEL_THRESHOLD = 4096;
+
+        private:
+            template <typename Body>
+            void run(size_t count, const Body& body) const;
+
+            std::unique_ptr<Utils::ThreadPool> pool;
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef HASH_BACKEND_H
+#define HASH_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // ONE-SHOT DIGEST PROVIDER BEHIND Hash::sha256Raw / Hash::ripemd160Raw
+        class HashBackend {
+        public:
+            virtual ~HashBackend() = default;
+
+            virtual const char* name() const = 0;
+            virtual bool available() const = 0;
+
+            virtual void sha256(const uint8_t* data, size_t length, uint8_t out[32]) const = 0;
+            virtual void ripemd160(const uint8_t* data, size_t length, uint8_t out[20]) const = 0;
+        };
+
+        struct BackendBenchmark {
+            std::string name;
+            double nanosPerHash = 0.0;             // SHA-256
+            double ripemd160NanosPerHash = 0.0;
+        };
+
+        // BACKEND SELECTION
+        // Candidates: "portable" (in-tree scalar), "native" (SHA-NI single stream,
+        // AVX2/SSE4.1 lanes for batches) and "openssl" (OpenSSL 3 EVP with fetched
+        // EVP_MD objects and thread-local contexts). With `crypto.hashBackend` set
+        // to "auto" (or absent) every available backend is micro-benchmarked and
+        // the fastest wins, separately for SHA-256 and RIPEMD-160 (the in-tree
+        // RIPEMD-160 is usually slower than EVP even where SHA-NI wins SHA-256).
+        // A named backend serves both.
+        class HashBackendRegistry {
+        public:
+            // Selected lazily on first use; call initialize() after the config is loaded to apply it
+            static const HashBackend& active();
+            // Backend serving Hash::ripemd160Raw; differs from active() only under "auto"
+            static const HashBackend& activeRipemd160();
+
+            // Probe, benchmark and apply `crypto.hashBackend`
+            static void initialize();
+
+            // "auto" re-runs the benchmark; returns false for unknown or unavailable names
+            static bool select(const std::string& name);
+
+            static std::vector<const HashBackend*> backends();
+            static std::vector<BackendBenchmark> benchmark();
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef HASHER_H
+#define HASHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // INCREMENTAL SHA-256 (INIT / UPDATE / FINALIZE)
+        // Plain value type: copying a hasher forks its midstate, so a shared
+        // prefix is compressed once and resumed for every suffix.
+        class Sha256Hasher {
+        public:
+            using DigestType = Digest256;
+            static constexpr size_t BLOCK_SIZE = 64;
+
+            Sha256Hasher();
+
+            Sha256Hasher& reset();
+            Sha256Hasher& update(const uint8_t* data, size_t length);
+            Sha256Hasher& update(ByteView data);
+
+            // Produces the digest and resets the hasher for reuse
+            Digest256 finalize();
+
+            // MIDSTATE ACCESS (ONLY MEANINGFUL ON A 64-BYTE BOUNDARY)
+            const uint32_t* midstate() const { return state; }
+            uint64_t bytesProcessed() const { return totalBytes; }
+            static Sha256Hasher fromMidstate(const uint32_t midstate[8], uint64_t bytesProcessed);
+
+        private:
+            uint32_t state[8];
+            uint8_t buffer[64];
+            uint64_t totalBytes;
+        };
+
+        // INCREMENTAL SHA-512 (128-BYTE BLOCKS, 128-BIT LENGTH FIELD)
+        class Sha512Hasher {
+        public:
+            using DigestType = Digest512;
+            static constexpr size_t BLOCK_SIZE = 128;
+
+            Sha512Hasher();
+
+            Sha512Hasher& reset();
+            Sha512Hasher& update(const uint8_t* data, size_t length);
+            Sha512Hasher& update(ByteView data);
+
+            // Produces the digest and resets the hasher for reuse
+            Digest512 finalize();
+
+            // MIDSTATE ACCESS (ONLY MEANINGFUL ON A 128-BYTE BOUNDARY)
+            const uint64_t* midstate() const { return state; }
+            uint64_t bytesProcessed() const { return totalBytes; }
+            static Sha512Hasher fromMidstate(const uint64_t midstate[8], uint64_t bytesProcessed);
+
+        private:
+            uint64_t state[8];
+            uint8_t buffer[128];
+            uint64_t totalBytes;
+        };
+
+        // INCREMENTAL SHA-256d (SHA-256 OF THE SHA-256 DIGEST)
+        class Sha256dHasher {
+        public:
+            using DigestType = Digest256;
+
+            Sha256dHasher& reset();
+            Sha256dHasher& update(const uint8_t* data, size_t length);
+            Sha256dHasher& update(ByteView data);
+            Digest256 finalize();
+
+        private:
+            Sha256Hasher inner;
+        };
+
+        // INCREMENTAL RIPEMD-160
+        class Ripemd160Hasher {
+        public:
+            using DigestType = Digest160;
+
+            Ripemd160Hasher();
+
+            Ripemd160Hasher& reset();
+            Ripemd160Hasher& update(const uint8_t* data, size_t length);
+            Ripemd160Hasher& update(ByteView data);
+            Digest160 finalize();
+
+        private:
+            uint32_t state[5];
+            uint8_t buffer[64];
+            uint64_t totalBytes;
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
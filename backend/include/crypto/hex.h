@@ -0,0 +1,70 @@
+#ifndef HEX_H
+#define HEX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        template <size_t N>
+        struct Digest;
+
+        // DECODE OUTCOME: ON FAILURE `errorOffset` IS THE FIRST BAD CHARACTER
+        // (OR THE INPUT LENGTH WHEN IT IS ODD / WRONG FOR A FIXED-SIZE TARGET)
+        struct HexDecodeResult {
+            bool ok = true;
+            size_t errorOffset = 0;
+
+            explicit operator bool() const { return ok; }
+        };
+
+        // HEX CODEC OVER CALLER-PROVIDED BUFFERS
+        // Table-driven scalar kernels plus SSSE3 (16 bytes/step) and AVX2
+        // (32 bytes/step) kernels, chosen once from CPUID. Lowercase output;
+        // decoding accepts either case.
+        class Hex {
+        public:
+            // `out` must hold 2 * length chars (no terminator is written)
+            static void encode(const uint8_t* in, size_t length, char* out);
+            // `out` must hold length / 2 bytes
+            static HexDecodeResult decode(const char* in, size_t length, uint8_t* out);
+
+            static std::string encode(const uint8_t* in, size_t length);
+
+            // FIXED-SIZE DIGEST OVERLOADS
+            template <size_t N>
+            static std::array<char, 2 * N> encode(const Digest<N>& digest) {
+                std::array<char, 2 * N> out;
+                encode(digest.data(), N, out.data());
+                return out;
+            }
+
+            template <size_t N>
+            static HexDecodeResult decode(const char* in, size_t length, Digest<N>& digest) {
+                if (length != 2 * N) {
+                    return {false, length < 2 * N ? length : 2 * N};
+                }
+                return decode(in, length, digest.data());
+            }
+
+            template <size_t N>
+            static HexDecodeResult decode(const std::string& hex, Digest<N>& digest) {
+                return decode(hex.data(), hex.size(), digest);
+            }
+
+            // INDIVIDUAL KERNELS (EXPOSED FOR BENCHMARKS)
+            static void encodeScalar(const uint8_t* in, size_t length, char* out);
+            static void encodeSsse3(const uint8_t* in, size_t length, char* out);
+            static void encodeAvx2(const uint8_t* in, size_t length, char* out);
+            static HexDecodeResult decodeScalar(const char* in, size_t length, uint8_t* out);
+            static HexDecodeResult decodeSsse3(const char* in, size_t length, uint8_t* out);
+            static HexDecodeResult decodeAvx2(const char* in, size_t length, uint8_t* out);
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef HMAC_H
+#define HMAC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "crypto/digest.h"
+#include "crypto/hasher.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // HMAC OVER AN INCREMENTAL HASHER (RFC 2104)
+        // The key is absorbed once into inner (key ^ 0x36) and outer (key ^ 0x5c)
+        // hashers. Both pads fill exactly one block, so each MAC resumes from
+        // their midstates and pays only for the message and the outer digest.
+        template <typename Hasher>
+        class Hmac {
+        public:
+            using DigestType = typename Hasher::DigestType;
+            static constexpr size_t BLOCK_SIZE = Hasher::BLOCK_SIZE;
+
+            Hmac(const uint8_t* key, size_t length) {
+                uint8_t block[BLOCK_SIZE] = {};
+                if (length > BLOCK_SIZE) {
+                    DigestType hashedKey = Hasher().update(key, length).finalize();
+                    std::memcpy(block, hashedKey.data(), hashedKey.size());
+                } else if (length) {
+                    std::memcpy(block, key, length);
+                }
+
+                uint8_t pad[BLOCK_SIZE];
+                for (size_t i = 0; i < BLOCK_SIZE; ++i) pad[i] = block[i] ^ 0x36;
+                innerPadded.update(pad, BLOCK_SIZE);
+                for (size_t i = 0; i < BLOCK_SIZE; ++i) pad[i] = block[i] ^ 0x5c;
+                outerPadded.update(pad, BLOCK_SIZE);
+                message = innerPadded;
+            }
+
+            explicit Hmac(ByteView key) : Hmac(key.data(), key.size()) {}
+
+            Hmac& update(const uint8_t* data, size_t length) {
+                message.update(data, length);
+                return *this;
+            }
+
+            Hmac& update(ByteView data) { return update(data.data(), data.size()); }
+
+            // Produces the MAC and rewinds to the keyed state for the next message
+            DigestType finalize() {
+                DigestType innerDigest = message.finalize();
+                message = innerPadded;
+                Hasher outer = outerPadded;
+                return outer.update(innerDigest.data(), innerDigest.size()).finalize();
+            }
+
+            DigestType mac(ByteView data) const {
+                Hmac copy = *this;
+                copy.message = innerPadded;
+                return copy.update(data).finalize();
+            }
+
+            // Hashers positioned right after the inner / outer pad block
+            const Hasher& innerPad() const { return innerPadded; }
+            const Hasher& outerPad() const { return outerPadded; }
+
+        private:
+            Hasher innerPadded;
+            Hasher outerPadded;
+            Hasher message;
+        };
+
+        using HmacSha256 = Hmac<Sha256Hasher>;
+        using HmacSha512 = Hmac<Sha512Hasher>;
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
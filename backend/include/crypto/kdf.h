@@ -0,0 +1,45 @@
+#ifndef KDF_H
+#define KDF_H
+
+#include <cstddef>
+#include <cstdint>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // ONE PBKDF2 DERIVATION: `outputLength` BYTES WRITTEN TO `output`
+        struct Pbkdf2Request {
+            ByteView password;
+            ByteView salt;
+            uint32_t iterations = 0;
+            uint8_t* output = nullptr;
+            size_t outputLength = 0;
+        };
+
+        // PASSWORD / KEY DERIVATION (RFC 8018 PBKDF2, RFC 5869 HKDF)
+        // PBKDF2 caches the HMAC pad midstates per password, so every iteration
+        // costs two compressions over a preformatted block. Batches spread the
+        // independent output blocks of all requests across SIMD lanes: 8-way
+        // (AVX2) / 4-way (SSE4.1) SHA-256 and 4-way (AVX2) SHA-512. Lanes are
+        // grouped by iteration count, so mixed counts waste little work.
+        class Kdf {
+        public:
+            static void pbkdf2Sha256(ByteView password, ByteView salt, uint32_t iterations,
+                                     uint8_t* output, size_t outputLength);
+            static void pbkdf2Sha512(ByteView password, ByteView salt, uint32_t iterations,
+                                     uint8_t* output, size_t outputLength);
+
+            static void pbkdf2Sha256Batch(const Pbkdf2Request* requests, size_t count);
+            static void pbkdf2Sha512Batch(const Pbkdf2Request* requests, size_t count);
+
+            // HKDF-SHA256: extract a pseudorandom key, then expand up to 255 * 32 bytes
+            static Digest256 hkdfExtract(ByteView salt, ByteView inputKey);
+            static void hkdfExpand(const Digest256& pseudoRandomKey, ByteView info, uint8_t* output, size_t outputLength);
+            static void hkdfSha256(ByteView inputKey, ByteView salt, ByteView info, uint8_t* output, size_t outputLength);
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
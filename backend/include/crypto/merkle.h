@@ -0,0 +1,60 @@
+#ifndef MERKLE_H
+#define MERKLE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace Utils {
+        class ThreadPool;
+    }
+
+    namespace SHA256 {
+
+        enum class MerkleMode {
+            // sha256d over raw 32-byte left||right pairs (Bitcoin layout)
+            BINARY,
+            // sha256d over the concatenated hex text of each pair, as Hash::merkleRoot always did
+            LEGACY_HEX
+        };
+
+        // ITERATIVE MERKLE ROOT ENGINE
+        // Levels are hashed in place of two scratch buffers that are reused
+        // across levels and calls; large levels are split across a thread pool.
+        class MerkleEngine {
+        public:
+            // threadCount == 0 takes `mining.threadCount` from the config
+            explicit MerkleEngine(size_t threadCount = 0);
+            ~MerkleEngine();
+
+            MerkleEngine(const MerkleEngine&) = delete;
+            MerkleEngine& operator=(const MerkleEngine&) = delete;
+
+            // BINARY MODE (EMPTY INPUT YIELDS THE ALL-ZERO DIGEST)
+            Digest256 root(const Digest256* leaves, size_t count) const;
+            Digest256 root(const std::vector<Digest256>& leaves) const;
+
+            // LEGACY_HEX reproduces Hash::merkleRoot byte for byte; BINARY decodes hex leaves first
+            std::string root(const std::vector<std::string>& hashes, MerkleMode mode) const;
+
+            size_t threadCount() const;
+
+            // Shared engine sized from the config on first use
+            static const MerkleEngine& shared();
+
+            // Levels with fewer pairs than this are hashed on the calling thread
+            static constexpr size_t PARALLEL_THRESHOLD = 2048;
+
+        private:
+            void hashLevel(const Digest256* in, Digest256* out, size_t pairs, MerkleMode mode) const;
+
+            std::unique_ptr<Utils::ThreadPool> pool;
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
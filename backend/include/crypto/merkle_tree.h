@@ -0,0 +1,74 @@
+#ifndef MERKLE_TREE_H
+#define MERKLE_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // INCLUSION PROOF: SIBLINGS FROM THE LEAF LEVEL UP TO (EXCLUDING) THE ROOT
+        struct MerkleProof {
+            uint64_t leafIndex = 0;
+            std::vector<Digest256> siblings;
+        };
+
+        // PERSISTENT MERKLE TREE WITH CACHED INTERIOR NODES
+        // Same layout as MerkleEngine in BINARY mode (odd tails paired with themselves),
+        // so root() always equals Hash::merkleRoot over the same leaves.
+        //
+        // All levels live in one flat array sized for a power-of-two capacity:
+        // level l starts at 2C - (2C >> l). Growing past the capacity relocates
+        // the cached nodes without rehashing them.
+        //
+        // Mutations are not synchronized; const members may run concurrently.
+        class MerkleTree {
+        public:
+            MerkleTree() = default;
+            explicit MerkleTree(const std::vector<Digest256>& leaves);
+
+            // O(n) bulk rebuild using the contiguous-pair sha256d kernel
+            void build(const std::vector<Digest256>& leaves);
+
+            // O(log n) UPDATES
+            void append(const Digest256& leaf);
+            void replace(size_t index, const Digest256& leaf);
+            void removeTail();
+
+            size_t size() const { return leafCount; }
+            bool empty() const { return leafCount == 0; }
+            const Digest256& leaf(size_t index) const;
+
+            // The all-zero digest for an empty tree
+            Digest256 root() const;
+
+            // PROOFS
+            MerkleProof proof(size_t index) const;
+            static bool verifyProof(const Digest256& root, const Digest256& leaf, const MerkleProof& proof);
+
+            // Verifies many proofs level by level so every level is one multi-lane kernel call
+            static std::vector<bool> verifyBatch(const Digest256& root, const std::vector<Digest256>& leaves,
+                                                 const std::vector<MerkleProof>& proofs);
+
+        private:
+            size_t levelOffset(size_t level) const { return 2 * capacity - ((2 * capacity) >> level); }
+            size_t levelSize(size_t level) const { return ((leafCount - 1) >> level) + 1; }
+            size_t levelCount() const;
+
+            Digest256& node(size_t level, size_t index) { return nodes[levelOffset(level) + index]; }
+            const Digest256& node(size_t level, size_t index) const { return nodes[levelOffset(level) + index]; }
+
+            void reserveLeaves(size_t count);
+            void rehashPath(size_t index);
+
+            std::vector<Digest256> nodes;
+            size_t capacity = 0;
+            size_t leafCount = 0;
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
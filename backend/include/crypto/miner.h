@@ -0,0 +1,77 @@
+#ifndef MINER_H
+#define MINER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace Utils {
+        class ThreadPool;
+    }
+
+    namespace SHA256 {
+
+        // 80-BYTE SERIALIZED HEADER: version | prevHash | merkleRoot | time | bits | nonce (little-endian fields)
+        using BlockHeader = std::array<uint8_t, 80>;
+
+        struct MinerThreadStats {
+            size_t threadIndex = 0;
+            uint64_t hashes = 0;
+            double seconds = 0.0;
+            double hashesPerSecond = 0.0;
+        };
+
+        struct MiningResult {
+            bool found = false;
+            uint32_t nonce = 0;
+            Digest256 hash;
+            uint64_t totalHashes = 0;
+            double seconds = 0.0;
+            std::vector<MinerThreadStats> threads;
+        };
+
+        // PROOF-OF-WORK NONCE SEARCH
+        // The first 64 header bytes are compressed once per template; each nonce
+        // then costs the second-block compression plus the 32-byte second hash,
+        // evaluated 8 (AVX2) or 4 (SSE4.1) nonces per kernel call.
+        class Miner {
+        public:
+            // threadCount == 0 takes `mining.threadCount` from the config
+            explicit Miner(size_t threadCount = 0);
+            ~Miner();
+
+            Miner(const Miner&) = delete;
+            Miner& operator=(const Miner&) = delete;
+
+            // Sweep [startNonce, startNonce + nonceCount) split across the threads
+            MiningResult mine(const BlockHeader& header, const Digest256& target,
+                              uint32_t startNonce = 0, uint64_t nonceCount = (uint64_t(1) << 32));
+
+            // Ask a running mine() to return early (safe from any thread)
+            void stop();
+
+            size_t threadCount() const { return threads; }
+
+            // HEADER / TARGET HELPERS
+            static BlockHeader makeHeader(uint32_t version, const Digest256& previousHash, const Digest256& merkleRoot,
+                                          uint32_t time, uint32_t bits, uint32_t nonce = 0);
+            // Expand compact nBits into a 256-bit little-endian target
+            static Digest256 targetFromCompact(uint32_t bits);
+            // Hash and target are both compared as 256-bit little-endian integers
+            static bool meetsTarget(const Digest256& hash, const Digest256& target);
+
+        private:
+            size_t threads;
+            std::unique_ptr<Utils::ThreadPool> pool;
+            std::atomic<bool> stopRequested{false};
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
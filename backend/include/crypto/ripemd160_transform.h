@@ -0,0 +1,35 @@
+#ifndef RIPEMD160_TRANSFORM_H
+#define RIPEMD160_TRANSFORM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Crypto {
+    namespace SHA256 {
+        namespace Ripemd160Transform {
+
+            extern const uint32_t INITIAL_STATE[5];
+
+            // SINGLE-STREAM COMPRESSION OF `blocks` CONSECUTIVE 64-BYTE BLOCKS
+            void compress(uint32_t state[5], const uint8_t* data, size_t blocks);
+
+            // MULTI-LANE COMPRESSION OF ONE BLOCK PER LANE
+            // `state` is word-major: state[word * LANES + lane]
+            void compress4Way(uint32_t state[20], const uint8_t* const blocks[4]);
+            void compress8Way(uint32_t state[40], const uint8_t* const blocks[8]);
+
+            // Lanes processed per kernel call (1, 4 or 8); pinned to 1 while the SHA-256 kernels are scalar
+            size_t laneWidth();
+
+            // Serialize a state as a little-endian digest
+            void storeDigest(const uint32_t state[5], uint8_t out[20]);
+
+            // RIPEMD-160 OF `count` CONTIGUOUS 32-BYTE INPUTS (SHA-256 DIGESTS) INTO 20-BYTE OUTPUTS
+            // A 32-byte message pads to exactly one block, so each input costs one compression.
+            void hash32(uint8_t* out, const uint8_t* in, size_t count);
+
+        } // namespace Ripemd160Transform
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
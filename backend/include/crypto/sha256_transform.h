@@ -0,0 +1,57 @@
+#ifndef SHA256_TRANSFORM_H
+#define SHA256_TRANSFORM_H
+
+#include <cstddef>
+#include <cstdint>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace SHA256 {
+        namespace Transform {
+
+            // COMPRESSION KERNEL FAMILIES
+            enum class Implementation {
+                SCALAR = 0,
+                SSE41 = 1,   // 4 independent lanes
+                AVX2 = 2,    // 8 independent lanes
+                SHANI = 3    // single stream, hardware rounds
+            };
+
+            extern const uint32_t INITIAL_STATE[8];
+
+            // BEST IMPLEMENTATION THE CPU SUPPORTS / CURRENTLY ACTIVE ONE
+            Implementation detect();
+            Implementation active();
+            bool isSupported(Implementation impl);
+            // Returns false (and keeps the current choice) if the CPU lacks the instructions
+            bool select(Implementation impl);
+            const char* implementationName(Implementation impl);
+
+            // SINGLE-STREAM COMPRESSION OF `blocks` CONSECUTIVE 64-BYTE BLOCKS
+            void compress(uint32_t state[8], const uint8_t* data, size_t blocks);
+            void compressScalar(uint32_t state[8], const uint8_t* data, size_t blocks);
+            void compressShaNi(uint32_t state[8], const uint8_t* data, size_t blocks);
+
+            // MULTI-LANE COMPRESSION OF ONE BLOCK PER LANE
+            // `state` is word-major: state[word * LANES + lane]
+            void compress4Way(uint32_t state[32], const uint8_t* const blocks[4]);
+            void compress8Way(uint32_t state[64], const uint8_t* const blocks[8]);
+
+            // Lanes processed per kernel call by the active implementation (1, 4 or 8)
+            size_t laneWidth();
+
+            // Serialize a state as a big-endian digest
+            void storeDigest(const uint32_t state[8], uint8_t out[32]);
+
+            // DOUBLE SHA-256 OF `count` CONTIGUOUS 64-BYTE INPUTS (MERKLE PAIRS) INTO 32-BYTE OUTPUTS
+            // Padding blocks are constants, so each input costs exactly three compressions.
+            void sha256d64(uint8_t* out, const uint8_t* in, size_t count);
+
+            // INDEPENDENT-MESSAGE BATCH HASHING (MULTI-BUFFER LANE REFILL)
+            void hashBatch(const ByteView* inputs, Digest256* outputs, size_t count, bool doubleHash);
+
+        } // namespace Transform
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SHA512_TRANSFORM_H
+#define SHA512_TRANSFORM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Crypto {
+    namespace SHA256 {
+        namespace Sha512Transform {
+
+            extern const uint64_t INITIAL_STATE[8];
+
+            // SINGLE-STREAM COMPRESSION OF `blocks` CONSECUTIVE 128-BYTE BLOCKS
+            void compress(uint64_t state[8], const uint8_t* data, size_t blocks);
+
+            // MULTI-LANE COMPRESSION OF ONE BLOCK PER LANE (AVX2, 4 x 64-BIT LANES)
+            // `state` is word-major: state[word * 4 + lane]
+            void compress4Way(uint64_t state[32], const uint8_t* const blocks[4]);
+
+            // Lanes processed per kernel call (1 or 4); pinned to 1 while the SHA-256 kernels are scalar
+            size_t laneWidth();
+
+            // Serialize a state as a big-endian digest
+            void storeDigest(const uint64_t state[8], uint8_t out[64]);
+
+        } // namespace Sha512Transform
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef SIPHASH_H
+#define SIPHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "crypto/digest.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // SIPHASH-2-4 (64-BIT OUTPUT, 128-BIT KEY AS TWO LITTLE-ENDIAN WORDS)
+        // Keyed short-input hash used to map filter elements into a uniform range.
+        class SipHasher {
+        public:
+            SipHasher(uint64_t k0, uint64_t k1) : k0(k0), k1(k1) {}
+
+            uint64_t operator()(const uint8_t* data, size_t length) const {
+                uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+                uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+                uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+                uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+                size_t blocks = length / 8;
+                for (size_t i = 0; i < blocks; ++i) {
+                    uint64_t m = load64(data + 8 * i);
+                    v3 ^= m;
+                    round(v0, v1, v2, v3);
+                    round(v0, v1, v2, v3);
+                    v0 ^= m;
+                }
+
+                // Last word: remaining bytes, length in the top byte
+                uint64_t last = static_cast<uint64_t>(length) << 56;
+                const uint8_t* tail = data + 8 * blocks;
+                for (size_t i = 0; i < length % 8; ++i) {
+                    last |= static_cast<uint64_t>(tail[i]) << (8 * i);
+                }
+                v3 ^= last;
+                round(v0, v1, v2, v3);
+                round(v0, v1, v2, v3);
+                v0 ^= last;
+
+                v2 ^= 0xff;
+                for (int i = 0; i < 4; ++i) {
+                    round(v0, v1, v2, v3);
+                }
+                return v0 ^ v1 ^ v2 ^ v3;
+            }
+
+            uint64_t operator()(ByteView data) const { return (*this)(data.data(), data.size()); }
+
+        private:
+            static uint64_t rotl(uint64_t x, int b) { return (x << b) | (x >> (64 - b)); }
+
+            static uint64_t load64(const uint8_t* p) {
+                uint64_t value = 0;
+                for (int i = 7; i >= 0; --i) {
+                    value = (value << 8) | p[i];
+                }
+                return value;
+            }
+
+            static void round(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+                v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);
+                v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;
+                v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;
+                v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);
+            }
+
+            uint64_t k0;
+            uint64_t k1;
+        };
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef TAGGED_HASH_H
+#define TAGGED_HASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "crypto/digest.h"
+#include "crypto/hasher.h"
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // COMPILE-TIME SHA-256 (TAG PREFIXES ONLY; RUNTIME HASHING USES Transform)
+        namespace ConstexprSha256 {
+
+            using State = std::array<uint32_t, 8>;
+
+            constexpr uint32_t K[64] = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+            };
+
+            constexpr State INITIAL_STATE = {
+                0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+            };
+
+            constexpr uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+            // One block given as 16 big-endian message words
+            constexpr State compress(State state, const std::array<uint32_t, 16>& block) {
+                uint32_t w[64] = {};
+                for (int i = 0; i < 16; ++i) {
+                    w[i] = block[i];
+                }
+                for (int i = 16; i < 64; ++i) {
+                    uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                    uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+                }
+
+                uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+                uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+                for (int i = 0; i < 64; ++i) {
+                    uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+                    uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                    h = g; g = f; f = e; e = d + t1;
+                    d = c; c = b; b = a; a = t1 + t2;
+                }
+
+                state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+                state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+                return state;
+            }
+
+            constexpr size_t length(const char* text) {
+                size_t n = 0;
+                while (text[n] != '\0') {
+                    ++n;
+                }
+                return n;
+            }
+
+            // Full SHA-256 of a byte string, returned as the final state words
+            constexpr State hash(const char* data, size_t size) {
+                State state = INITIAL_STATE;
+                size_t total = (size + 9 + 63) / 64 * 64;
+                for (size_t offset = 0; offset < total; offset += 64) {
+                    std::array<uint32_t, 16> block = {};
+                    for (size_t i = 0; i < 64; ++i) {
+                        size_t position = offset + i;
+                        uint32_t byte = 0;
+                        if (position < size) {
+                            byte = static_cast<uint8_t>(data[position]);
+                        } else if (position == size) {
+                            byte = 0x80;
+                        } else if (position >= total - 8) {
+                            byte = static_cast<uint32_t>((static_cast<uint64_t>(size) * 8) >> (8 * (total - 1 - position))) & 0xff;
+                        }
+                        block[i / 4] |= byte << (8 * (3 - i % 4));
+                    }
+                    state = compress(state, block);
+                }
+                return state;
+            }
+
+            // Midstate after the 64-byte prefix SHA256(tag) || SHA256(tag)
+            constexpr State tagMidstate(const char* tag, size_t size) {
+                State tagHash = hash(tag, size);
+                std::array<uint32_t, 16> block = {};
+                for (int i = 0; i < 8; ++i) {
+                    block[i] = tagHash[i];
+                    block[i + 8] = tagHash[i];
+                }
+                return compress(INITIAL_STATE, block);
+            }
+
+        } // namespace ConstexprSha256
+
+        // BIP340 TAGGED HASH: SHA256(SHA256(tag) || SHA256(tag) || msg)
+        // The tag prefix is exactly one block, so its midstate is computed once
+        // (at compile time for constexpr instances) and every call resumes from it.
+        class TaggedHash {
+        public:
+            constexpr explicit TaggedHash(const char* tag)
+                : state(ConstexprSha256::tagMidstate(tag, ConstexprSha256::length(tag))) {}
+
+            constexpr TaggedHash(const char* tag, size_t length)
+                : state(ConstexprSha256::tagMidstate(tag, length)) {}
+
+            // Hasher positioned after the tag prefix, ready for the message
+            Sha256Hasher hasher() const { return Sha256Hasher::fromMidstate(state.data(), 64); }
+
+            Digest256 operator()(const uint8_t* data, size_t length) const {
+                return hasher().update(data, length).finalize();
+            }
+
+            Digest256 operator()(ByteView data) const { return (*this)(data.data(), data.size()); }
+
+            constexpr const ConstexprSha256::State& midstate() const { return state; }
+
+        private:
+            ConstexprSha256::State state;
+        };
+
+        // WELL-KNOWN TAGS (MIDSTATES BAKED INTO THE BINARY)
+        namespace Tags {
+            inline constexpr TaggedHash BIP340_CHALLENGE{"BIP0340/challenge"};
+            inline constexpr TaggedHash BIP340_AUX{"BIP0340/aux"};
+            inline constexpr TaggedHash BIP340_NONCE{"BIP0340/nonce"};
+            inline constexpr TaggedHash TAP_LEAF{"TapLeaf"};
+            inline constexpr TaggedHash TAP_BRANCH{"TapBranch"};
+            inline constexpr TaggedHash TAP_TWEAK{"TapTweak"};
+            inline constexpr TaggedHash TAP_SIGHASH{"TapSighash"};
+        } // namespace Tags
+
+    } // namespace SHA256
+} // namespace Crypto
+
+#endif
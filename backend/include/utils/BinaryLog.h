@@ -0,0 +1,180 @@
+#ifndef BINARYLOG_H
+#define BINARYLOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "utils/LogSink.h"
+
+namespace Crypto {
+    namespace Utils {
+
+        enum class LogLevel;
+
+        // ON-DISK LAYOUT (LITTLE-ENDIAN), SHARED WITH tools/log_decode
+        //   header : MAGIC[8] u64 steadyNanos u64 systemNanos   (clock pair taken at open)
+        //   FORMAT : u8 type u32 id u8 level u8 argCount u8 argTypes[argCount]
+        //            u16 length format  u16 length file  u32 line
+        //   CHUNK  : u8 type u32 thread u32 length, then `length` bytes of events
+        //   event  : u32 id u64 steadyNanos, then each argument:
+        //            INT64 / UINT64 / DOUBLE as 8 bytes, BOOL / CHAR as 1 byte,
+        //            STRING as u16 length + bytes
+        namespace BinaryLogFormat {
+            constexpr char MAGIC[8] = {'C', 'R', 'Y', 'B', 'L', 'O', 'G', '1'};
+            constexpr size_t HEADER_SIZE = 8 + 8 + 8;
+
+            enum RecordType : uint8_t {
+                FORMAT = 1,
+                CHUNK = 2
+            };
+
+            enum ArgType : uint8_t {
+                INT64 = 1,
+                UINT64 = 2,
+                DOUBLE = 3,
+                STRING = 4,
+                BOOL = 5,
+                CHAR = 6
+            };
+
+            constexpr size_t MAX_STRING = 0xffff;
+
+            // Type code and encoding for each supported argument type
+            template <typename T, typename Enable = void>
+            struct Codec;
+
+            template <>
+            struct Codec<bool> {
+                static constexpr ArgType TYPE = BOOL;
+                static size_t size(bool) { return 1; }
+                static void put(uint8_t*& out, bool value) { *out++ = value ? 1 : 0; }
+            };
+
+            template <>
+            struct Codec<char> {
+                static constexpr ArgType TYPE = CHAR;
+                static size_t size(char) { return 1; }
+                static void put(uint8_t*& out, char value) { *out++ = static_cast<uint8_t>(value); }
+            };
+
+            template <typename T>
+            struct Codec<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                                    !std::is_same<T, char>::value>::type> {
+                static constexpr ArgType TYPE = std::is_signed<T>::value ? INT64 : UINT64;
+                static size_t size(T) { return 8; }
+                static void put(uint8_t*& out, T value) {
+                    uint64_t raw = static_cast<uint64_t>(value);
+                    std::memcpy(out, &raw, 8);
+                    out += 8;
+                }
+            };
+
+            template <typename T>
+            struct Codec<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+                static constexpr ArgType TYPE = DOUBLE;
+                static size_t size(T) { return 8; }
+                static void put(uint8_t*& out, T value) {
+                    double raw = static_cast<double>(value);
+                    std::memcpy(out, &raw, 8);
+                    out += 8;
+                }
+            };
+
+            struct StringCodec {
+                static constexpr ArgType TYPE = STRING;
+                static size_t clamp(size_t length) { return length < MAX_STRING ? length : MAX_STRING; }
+                static void putBytes(uint8_t*& out, const char* data, size_t length) {
+                    uint16_t stored = static_cast<uint16_t>(clamp(length));
+                    std::memcpy(out, &stored, 2);
+                    std::memcpy(out + 2, data, stored);
+                    out += 2 + stored;
+                }
+            };
+
+            template <>
+            struct Codec<std::string> : StringCodec {
+                static size_t size(const std::string& value) { return 2 + clamp(value.size()); }
+                static void put(uint8_t*& out, const std::string& value) { putBytes(out, value.data(), value.size()); }
+            };
+
+            template <>
+            struct Codec<const char*> : StringCodec {
+                static size_t size(const char* value) { return 2 + clamp(std::strlen(value)); }
+                static void put(uint8_t*& out, const char* value) { putBytes(out, value, std::strlen(value)); }
+            };
+
+            template <>
+            struct Codec<char*> : Codec<const char*> {};
+
+            // Arrays (string literals) and cv/ref-qualified types share their decayed type's codec
+            template <typename T>
+            using CodecFor = Codec<typename std::decay<T>::type>;
+        }
+
+        // BINARY STRUCTURED LOG
+        // Each call site registers its format string once and gets an ID; after
+        // that a record is the ID, a steady-clock timestamp and the raw argument
+        // bytes, appended to a per-thread buffer under an uncontended spin flag.
+        // Full buffers are written to the sink as one chunk. Text rendering is left
+        // to the offline decoder (tools/log_decode).
+        class BinaryLog {
+        public:
+            static constexpr size_t THREAD_BUFFER_SIZE = 64 * 1024;
+            // While open, a background thread flushes every buffer this often
+            static constexpr unsigned FLUSH_INTERVAL_MS = 1000;
+
+            // Starts a new stream on `sink` (header plus every format registered so far)
+            static void open(std::shared_ptr<LogSink> sink);
+            // Convenience: append to a FileSink at `filePath`
+            static void open(const std::string& filePath);
+            // Flushes every thread's buffer and detaches the sink
+            static void close();
+            // Writes every thread's buffered records to the sink (also done periodically and by Logger::flush)
+            static void flush();
+            static bool isOpen() { return active.load(std::memory_order_acquire); }
+
+            // Called once per call site (via the SLOG_* macros); returns the format ID
+            template <typename... Args>
+            static uint32_t registerFormat(LogLevel level, const char* file, int line, const char* format, const Args&...) {
+                const uint8_t types[] = {BinaryLogFormat::CodecFor<Args>::TYPE..., 0};
+                return registerFormat(level, format, file, line, types, sizeof...(Args));
+            }
+
+            static uint32_t registerFormat(LogLevel level, const char* format, const char* file, int line,
+                                           const uint8_t* types, size_t argCount);
+
+            template <typename... Args>
+            static void write(uint32_t id, const char*, const Args&... args) {
+                size_t size = 4 + 8;
+                ((size += BinaryLogFormat::CodecFor<Args>::size(args)), ...);
+                uint8_t* out = reserve(size);
+                if (!out) {
+                    return;
+                }
+                uint64_t now = steadyNanos();
+                std::memcpy(out, &id, 4);
+                std::memcpy(out + 4, &now, 8);
+                out += 12;
+                (BinaryLogFormat::CodecFor<Args>::put(out, args), ...);
+                commit();
+            }
+
+            // Records dropped because a single record exceeded THREAD_BUFFER_SIZE
+            static uint64_t oversizedCount();
+
+        private:
+            static uint64_t steadyNanos();
+            // Locks the calling thread's buffer and returns room for `size` bytes (nullptr when closed or oversized)
+            static uint8_t* reserve(size_t size);
+            static void commit();
+
+            static std::atomic<bool> active;
+        };
+    } // namespace Utils
+} // namespace Crypto
+
+#endif
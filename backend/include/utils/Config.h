@@ -2,29 +2,146 @@
 #define CONFIG_H
 
 #include <nlohmann/json.hpp>
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <mutex>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace Crypto {
     namespace Utils {
         using json = nlohmann::json;
 
+        // Raised when a config document does not match the schema
+        class ConfigException : public std::runtime_error {
+        public:
+            explicit ConfigException(const std::string& message)
+                : std::runtime_error("Config Error: " + message) {}
+        };
+
+        // TYPED SCHEMA
+        // Missing keys keep these defaults; present keys must have the right type and range.
+        struct BlockchainSettings {
+            std::string networkName;
+            int targetBlockTime = 0;      // seconds, > 0 when set
+            int maxBlockSize = 0;         // bytes, > 0 when set
+        };
+
+        struct NetworkSettings {
+            int port = 0;                 // 1..65535 when set
+            std::string bindAddress;
+            int maxConnections = 0;       // >= 0
+        };
+
+        struct MiningSettings {
+            bool enableMining = false;
+            int threadCount = 0;          // >= 0; 0 = hardware concurrency
+        };
+
+        // IMMUTABLE VIEW OF ONE LOADED CONFIG FILE
+        // Built and validated once per load. Typed sections are plain members;
+        // `document` keeps the full tree for keys outside the schema, reached
+        // through ConfigKey handles whose resolution is memoized per snapshot.
+        class ConfigSnapshot {
+        public:
+            static constexpr size_t MAX_KEYS = 256;
+
+            // Throws ConfigException if `document` violates the schema
+            explicit ConfigSnapshot(json document);
+
+            ConfigSnapshot(const ConfigSnapshot&) = delete;
+            ConfigSnapshot& operator=(const ConfigSnapshot&) = delete;
+
+            BlockchainSettings blockchain;
+            NetworkSettings network;
+            MiningSettings mining;
+            const json document;
+
+            // Node at a pre-split path, or nullptr; no allocation, no copies
+            const json* find(const std::vector<std::string>& path) const;
+            // Same, for a dotted key
+            const json* find(const std::string& dottedKey) const;
+
+        private:
+            friend class ConfigKey;
+
+            const json* resolve(size_t id, const std::vector<std::string>& path) const;
+
+            // Per-handle memo: UNRESOLVED until first use, then the node (or nullptr)
+            mutable std::unique_ptr<std::atomic<const json*>[]> resolved;
+        };
+
+        // PRECOMPILED LOOKUP KEY
+        // Splits its dotted key once at construction. A lookup is one load of the
+        // current snapshot plus one atomic load of the memoized node, so handles
+        // are meant to be long-lived (static) objects.
+        class ConfigKey {
+        public:
+            // Handles with the same key share one memo slot. Slots are never freed,
+            // so the limit counts distinct keys ever constructed, not live handles:
+            // throws ConfigException for a new key once ConfigSnapshot::MAX_KEYS exist.
+            explicit ConfigKey(const std::string& dottedKey);
+
+            const std::string& key() const { return dottedKey; }
+
+            // Node in the current snapshot, or null when absent. The pointer shares
+            // ownership of its snapshot, so it stays valid across reloads.
+            std::shared_ptr<const json> find() const;
+
+            std::string getString(const std::string& fallback = "") const;
+            int getInt(int fallback = 0) const;
+            bool getBool(bool fallback = false) const;
+
+        private:
+            std::string dottedKey;
+            std::vector<std::string> path;
+            size_t id;
+        };
+
+        // Called after a new snapshot is published, on the thread that loaded it.
+        // Both snapshots are valid for the duration of the call; take
+        // Config::settings() to keep the new one longer. A listener must not call
+        // loadConfig() itself.
+        using ConfigListener = std::function<void(const ConfigSnapshot& previous, const ConfigSnapshot& next)>;
+
         class Config {
         private:
             static std::unique_ptr<Config> instance;
+            static std::atomic<Config*> current;
             static std::mutex mutex_;
+            static std::shared_ptr<const ConfigSnapshot> published;    // accessed with std::atomic_load/atomic_store
 
-            json configData;
             Config();
 
+            static void publish(std::shared_ptr<const ConfigSnapshot> snapshot);
+
         public:
             Config(const Config&) = delete;
             Config& operator=(const Config&) = delete;
 
             static Config* getInstance();
+            // Parses and validates `filePath`; on failure the previous snapshot stays active
             static bool loadConfig(const std::string& filePath);
 
+            // Current snapshot (defaults before the first load). The caller shares
+            // ownership, so a superseded snapshot is freed when its last holder lets go.
+            static std::shared_ptr<const ConfigSnapshot> settings();
+
+            // HOT RELOAD
+            // Returns an id for unsubscribe()
+            static size_t subscribe(ConfigListener listener);
+            static void unsubscribe(size_t id);
+            // Reloads `filePath` whenever it is written or replaced (inotify on its
+            // directory, debounced). Parsing and validation run on the watcher
+            // thread; readers keep the old snapshot until the new one is swapped in,
+            // and a rejected file leaves it in place. Throws std::runtime_error if
+            // the directory cannot be watched.
+            static void watch(const std::string& filePath);
+            static void stopWatching();
+
             static std::string getString(const std::string& key);
             static int getInt(const std::string& key);
             static bool getBool(const std::string& key);
@@ -1,6 +1,9 @@
 #ifndef JSONHELPER_H
 #define JSONHELPER_H
 #include <nlohmann/json.hpp>
+#include <string>
+#include <type_traits>
+#include <vector>
 namespace Crypto {
     namespace Utils {
 
@@ -11,6 +14,38 @@ namespace Crypto {
                 : std::runtime_error("JSON Error: " + message) {}
         };
 
+        // PRECOMPILED NESTED PATH
+        // Splits "block.header.nonce" (or the JSON pointer "/block/header/nonce")
+        // once; find() then walks the document by reference with no copies and
+        // no allocation. All-digit segments also index into arrays
+        // ("transactions.0.txid"). Meant to be built once and reused.
+        class JSONPath {
+        public:
+            using json = nlohmann::json;
+
+            // Dotted path; empty segments are ignored, so "" addresses the root
+            explicit JSONPath(const std::string& dottedPath);
+            // RFC 6901 pointer; throws JSONException if it is malformed
+            static JSONPath fromPointer(const std::string& pointer);
+
+            // Node at this path, or nullptr when any segment is missing
+            const json* find(const json& root) const;
+
+            const std::vector<std::string>& segments() const { return parts; }
+            // The same path as a json_pointer, for nlohmann APIs (at(), patch, flatten)
+            const json::json_pointer& pointer() const { return compiled; }
+
+        private:
+            static constexpr size_t NOT_AN_INDEX = static_cast<size_t>(-1);
+
+            JSONPath() = default;
+            void compile();
+
+            std::vector<std::string> parts;
+            std::vector<size_t> indices;      // array index per segment, or NOT_AN_INDEX
+            json::json_pointer compiled;
+        };
+
         class JSONHelper {
             using json = nlohmann::json;
         public:
@@ -36,8 +71,23 @@ namespace Crypto {
             static bool getBool(const json& jsonObj, const std::string& key, bool defaultValue = false);
 
             // SAFE NESTED ACCESS
+            // Copies only the addressed node; null when absent
             static json getNestedValue(const json& jsonObj, const std::string& path);
 
+            // Node inside `jsonObj` (no copy), or nullptr when absent
+            static const json* findNested(const json& jsonObj, const std::string& path);
+            static const json* findNested(const json& jsonObj, const JSONPath& path) { return path.find(jsonObj); }
+
+            // Typed nested read: `defaultValue` when the node is absent or holds another type
+            template <typename T>
+            static T getNested(const json& jsonObj, const JSONPath& path, const T& defaultValue = T()) {
+                return convertOr(path.find(jsonObj), defaultValue);
+            }
+            template <typename T>
+            static T getNested(const json& jsonObj, const std::string& path, const T& defaultValue = T()) {
+                return convertOr(findNested(jsonObj, path), defaultValue);
+            }
+
             static bool hasKey(const json& jsonObj, const std::string& key);
             static bool hasNestedKey(const json& jsonObj, const std::string& path);
 
@@ -59,7 +109,31 @@ namespace Crypto {
         private:
             // HELPER
             static std::vector<std::string> splitPath(const std::string& path);
-            static json navigateToPath(const json& jsonObj, const std::vector<std::string>& pathParts);
+            static const json* navigateToPath(const json& jsonObj, const std::vector<std::string>& pathParts);
+
+            template <typename T>
+            static T convertOr(const json* node, const T& defaultValue) {
+                if (!node) {
+                    return defaultValue;
+                }
+                if constexpr (std::is_same<T, json>::value) {
+                    return *node;
+                } else if constexpr (std::is_same<T, bool>::value) {
+                    return node->is_boolean() ? node->template get<T>() : defaultValue;
+                } else if constexpr (std::is_integral<T>::value) {
+                    return node->is_number_integer() ? node->template get<T>() : defaultValue;
+                } else if constexpr (std::is_floating_point<T>::value) {
+                    return node->is_number() ? node->template get<T>() : defaultValue;
+                } else if constexpr (std::is_same<T, std::string>::value) {
+                    return node->is_string() ? node->template get<T>() : defaultValue;
+                } else {
+                    try {
+                        return node->template get<T>();
+                    } catch (const json::exception&) {
+                        return defaultValue;
+                    }
+                }
+            }
 
         };
     } // namespace Utils
@@ -0,0 +1,91 @@
+#ifndef JSONSTREAM_H
+#define JSONSTREAM_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace Crypto {
+    namespace Utils {
+
+        struct JSONStreamOptions {
+            // Members with these names are dropped from every record, at any depth, without being built
+            std::vector<std::string> skipKeys;
+            // Upper bound on values (scalars and containers) in one record; 0 = unlimited.
+            // A larger record raises JSONException instead of growing without limit.
+            size_t maxRecordValues = 0;
+            // Mapped pages behind the parser are released every this many bytes (file input only)
+            size_t discardInterval = 16 * 1024 * 1024;
+        };
+
+        struct JSONLinesOptions {
+            // Every line must be an object (anything else is an invalid line) holding these
+            // (checked with JSONHelper::validateRequiredFields)
+            std::vector<std::string> requiredFields;
+            // Target chunk size; chunks always end on a newline
+            size_t chunkBytes = 256 * 1024;
+            // Parser threads; 0 = ThreadPool::configuredThreadCount()
+            size_t threads = 0;
+            // Parsed chunks waiting for delivery; 0 = four per thread. Bounds memory when the handler is slow.
+            size_t maxChunksInFlight = 0;
+            // Throw JSONException on the first invalid line instead of reporting and skipping it
+            bool stopOnError = false;
+        };
+
+        struct JSONLinesStats {
+            size_t lines = 0;       // non-blank lines seen
+            size_t records = 0;     // lines delivered to the handler
+            size_t invalid = 0;     // lines that failed to parse or validate
+            size_t bytes = 0;
+            double seconds = 0.0;
+
+            double linesPerSecond() const { return seconds > 0.0 ? static_cast<double>(lines) / seconds : 0.0; }
+        };
+
+        // STREAMING RECORD READER
+        // Walks a JSON document with the SAX parser and materializes one record
+        // at a time, so memory follows the largest record rather than the file.
+        // Records are the elements of the array(s) at `recordPath`, a dotted path
+        // where "*" matches any member or element: "" is the top-level array,
+        // "block.transactions" the transactions of one block, "blocks.*.transactions"
+        // every transaction of a chain export. Subtrees off that path are parsed
+        // but never built.
+        class JSONStream {
+        public:
+            using json = nlohmann::json;
+
+            // Receives each record (free to move from) and its ordinal; return false to stop early
+            using RecordHandler = std::function<bool(json& record, size_t index)>;
+
+            // Memory-maps `filePath`. Returns the number of records delivered; throws
+            // JSONException on malformed input, with the byte offset.
+            static size_t forEachRecord(const std::string& filePath, const std::string& recordPath,
+                                        const RecordHandler& handler, const JSONStreamOptions& options = {});
+
+            // Same, over text already in memory
+            static size_t forEachRecord(const char* data, size_t size, const std::string& recordPath,
+                                        const RecordHandler& handler, const JSONStreamOptions& options = {});
+
+            // JSON LINES INGEST
+            // Receives a record and its 1-based line number; return false to stop early
+            using LineHandler = std::function<bool(json& record, size_t lineNumber)>;
+            // Receives each invalid line's number and the reason
+            using LineErrorHandler = std::function<void(size_t lineNumber, const std::string& error)>;
+
+            // Memory-maps a newline-delimited JSON file, parses and validates
+            // newline-aligned chunks on a worker pool, and calls `handler` on the
+            // calling thread in file order. Blank lines are ignored. Invalid lines go
+            // to `onError` (logged when it is empty) unless `stopOnError` is set.
+            static JSONLinesStats ingestLines(const std::string& filePath, const LineHandler& handler,
+                                              const JSONLinesOptions& options = {}, const LineErrorHandler& onError = nullptr);
+
+            // Same, over text already in memory
+            static JSONLinesStats ingestLines(const char* data, size_t size, const LineHandler& handler,
+                                              const JSONLinesOptions& options = {}, const LineErrorHandler& onError = nullptr);
+        };
+    } // namespace Utils
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef LOGSINK_H
+#define LOGSINK_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Crypto {
+    namespace Utils {
+
+        // LOG OUTPUT DESTINATION
+        // Receives already formatted text, possibly many lines per call; the
+        // logger calls flush() once a burst has been written, not per line.
+        class LogSink {
+        public:
+            virtual ~LogSink() = default;
+
+            virtual void write(const char* data, size_t length) = 0;
+            virtual void flush() = 0;
+        };
+
+        // STANDARD OUTPUT
+        class ConsoleSink : public LogSink {
+        public:
+            void write(const char* data, size_t length) override;
+            void flush() override;
+        };
+
+        // APPEND-ONLY FILE (BUFFERED BY STDIO, WRITTEN THROUGH ON flush())
+        class FileSink : public LogSink {
+        public:
+            // Throws std::runtime_error if the file cannot be opened
+            explicit FileSink(const std::string& filePath);
+            ~FileSink() override;
+
+            FileSink(const FileSink&) = delete;
+            FileSink& operator=(const FileSink&) = delete;
+
+            void write(const char* data, size_t length) override;
+            void flush() override;
+
+        private:
+            std::FILE* file;
+        };
+
+        // WHEN A RotatingFileSink STARTS A NEW SEGMENT AND WHAT IT KEEPS
+        struct RotationPolicy {
+            size_t maxBytes = 64 * 1024 * 1024;        // 0 = no size limit
+            std::chrono::seconds maxAge{0};            // 0 = no time limit
+            size_t maxSegments = 10;                   // rotated segments kept, oldest deleted first; 0 = keep all
+            bool compress = true;                      // gzip rotated segments in the background
+            int compressionLevel = 6;
+        };
+
+        // SIZE/TIME-ROTATED TEXT LOG FILE
+        // The active segment is always `filePath`. On rotation it is renamed to
+        // `filePath.YYYYmmdd-HHMMSS.NNNNNN` and a fresh file is opened, which costs
+        // the writer a rename and an fopen; gzip compression and pruning of old
+        // segments happen on a low-priority background thread. Rotation only
+        // happens between write() calls, so a batch of lines never straddles two
+        // segments. If the new file cannot be created (full disk, no descriptors),
+        // writes continue in the current segment, the failure is reported once on
+        // stderr, and rotation is retried after another full segment. Meant for
+        // text logs: binary log streams need their header at the start of every
+        // file. Like FileSink, calls must be serialized by the caller (the Logger
+        // does this).
+        class RotatingFileSink : public LogSink {
+        public:
+            // Throws std::runtime_error if the file cannot be opened
+            explicit RotatingFileSink(const std::string& filePath, RotationPolicy policy = RotationPolicy());
+            // Finishes compressing every rotated segment before returning
+            ~RotatingFileSink() override;
+
+            RotatingFileSink(const RotatingFileSink&) = delete;
+            RotatingFileSink& operator=(const RotatingFileSink&) = delete;
+
+            void write(const char* data, size_t length) override;
+            void flush() override;
+
+            const std::string& path() const { return filePath; }
+
+        private:
+            void openSegment();
+            void rotate();
+            void compressLoop();
+            void compressSegment(const std::string& segmentPath);
+            void pruneSegments();
+
+            std::string filePath;
+            RotationPolicy policy;
+            std::FILE* file = nullptr;
+            size_t segmentBytes = 0;
+            std::chrono::steady_clock::time_point segmentOpened;
+            uint64_t rotationCount = 0;
+            bool rotationFailed = false;      // reported once until a rotation succeeds
+
+            std::mutex queueMutex;
+            std::condition_variable queueReady;
+            std::deque<std::string> pending;
+            bool stopping = false;
+            std::thread compressor;
+        };
+    } // namespace Utils
+} // namespace Crypto
+
+#endif
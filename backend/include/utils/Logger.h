@@ -1,9 +1,23 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "utils/BinaryLog.h"
+#include "utils/LogSink.h"
+
+// Levels below this (0 = DEBUG ... 4 = CRITICAL) are removed at compile time by the LOG_* macros
+#ifndef CRYPTO_MIN_LOG_LEVEL
+#define CRYPTO_MIN_LOG_LEVEL 0
+#endif
 
 namespace Crypto {
     namespace Utils {
@@ -16,37 +30,189 @@ namespace Crypto {
             CRITICAL = 4
         };
 
+        // WHAT AN ASYNC PRODUCER DOES WHEN THE QUEUE IS FULL
+        enum class LogOverflowPolicy {
+            BLOCK,    // wait for the sink thread to make room
+            DROP      // discard the message and count it
+        };
+
+        // Created on first use and never destroyed, so statements in static
+        // destructors and late-exiting threads always reach a live logger.
+        // shutdown() (also run at exit) drains the async queue and binary log.
         class Logger {
-            static std::unique_ptr<Logger> instance;
+            static std::atomic<Logger*> current;
             static std::mutex mutex_;
             static std::string logLevelToString(LogLevel level);
             static std::string getCurrentTime();
 
+            struct AsyncState;
+
             Logger();
 
-        public: 
+            void writeSync(LogLevel level, const std::string& message);
+            void sinkLoop(AsyncState* state);
+            void stopAsyncLocked();    // caller holds `mutex_`
+
+            std::mutex sinkMutex;
+            std::vector<std::shared_ptr<LogSink>> sinks;
+            std::unique_ptr<AsyncState> async;
+            std::atomic<AsyncState*> activeAsync{nullptr};
+            std::vector<std::unique_ptr<AsyncState>> retired;
+            std::atomic<int> minimumLevel{static_cast<int>(LogLevel::DEBUG)};
+            std::shared_ptr<LogSink> fileSink;    // the sink owned by `logging.file`
+            bool shutDown = false;                // guarded by `sinkMutex`
+
+        public:
+            static constexpr size_t DEFAULT_QUEUE_CAPACITY = 8192;
+
             Logger(const Logger&) = delete;
             Logger& operator=(const Logger&) = delete;
 
-            void debug(const std::string& message);
-            void info(const std::string& message);
-            void warning(const std::string& message);
-            void error(const std::string& message);
-            void critical(const std::string& message);
+            void debug(std::string message);
+            void info(std::string message);
+            void warning(std::string message);
+            void error(std::string message);
+            void critical(std::string message);
 
 
             static Logger* getInstance();
-            void log(LogLevel level, const std::string& message);
-            ~Logger();
+            void log(LogLevel level, std::string message);
+
+            // RUNTIME LEVEL FILTER (`logging.level` IN CONFIG)
+            void setLevel(LogLevel level) { minimumLevel.store(static_cast<int>(level), std::memory_order_relaxed); }
+            LogLevel level() const { return static_cast<LogLevel>(minimumLevel.load(std::memory_order_relaxed)); }
+            bool isEnabled(LogLevel level) const {
+                return static_cast<int>(level) >= CRYPTO_MIN_LOG_LEVEL &&
+                       static_cast<int>(level) >= minimumLevel.load(std::memory_order_relaxed);
+            }
+            // "debug", "info", "warning", "error" or "critical" (case-insensitive); false if unrecognized
+            static bool parseLevel(const std::string& name, LogLevel& level);
+
+            // SINKS (CONSOLE BY DEFAULT)
+            void addSink(std::shared_ptr<LogSink> sink);
+            void removeSink(const std::shared_ptr<LogSink>& sink);
+            void clearSinks();
+
+            // ASYNC MODE
+            // Producers push into a bounded lock-free MPSC ring; one background
+            // thread formats, batches and writes to the sinks, flushing when the
+            // queue runs dry. stopAsync() drains everything before returning.
+            // Calling startAsync() while running with a different capacity or
+            // policy drains the current queue and restarts with the new ones.
+            void startAsync(size_t queueCapacity = DEFAULT_QUEUE_CAPACITY,
+                            LogOverflowPolicy policy = LogOverflowPolicy::BLOCK);
+            void stopAsync();
+            bool isAsync() const { return activeAsync.load(std::memory_order_acquire) != nullptr; }
+            // Messages discarded under LogOverflowPolicy::DROP since startAsync()
+            uint64_t droppedCount() const;
+            // Blocks until everything logged so far has reached the sinks
+            void flush();
+
+            // BINARY MODE (SLOG_* STATEMENTS GO TO A RECORD STREAM; DECODE WITH tools/log_decode)
+            void startBinary(const std::string& filePath);
+            void stopBinary();
+
+            // Applies `logging.level`, `logging.async`, `logging.queueCapacity`, `logging.overflowPolicy`
+            // ("block" / "drop"), `logging.binaryPath` and `logging.file` (a RotatingFileSink:
+            // `path`, `maxBytes`, `maxAgeSeconds`, `maxSegments`, `compress`, `compressionLevel`)
+            void configure();
+
+            // Drains and stops async mode, closes the binary log and flushes the sinks.
+            // Later statements are written synchronously. Idempotent.
+            void shutdown();
         };
 
-        #define LOG_DEBUG(msg) Crypto::Utils::Logger::getInstance()->debug(msg)
-        #define LOG_INFO(msg) Crypto::Utils::Logger::getInstance()->info(msg)
-        #define LOG_WARNING(msg) Crypto::Utils::Logger::getInstance()->warning(msg)
-        #define LOG_ERROR(msg) Crypto::Utils::Logger::getInstance()->error(msg)
-        #define LOG_CRITICAL(msg) Crypto::Utils::Logger::getInstance()->critical(msg)
+        // MESSAGE ASSEMBLY FOR THE LOG_* MACROS
+        // Arguments are appended in order: strings as-is, characters as
+        // characters, numbers through std::to_string.
+        namespace LogFormat {
+            inline void append(std::string& out, const std::string& part) { out += part; }
+            inline void append(std::string& out, const char* part) { out += part; }
+            inline void append(std::string& out, char part) { out += part; }
+            inline void append(std::string& out, bool part) { out += part ? "true" : "false"; }
+
+            template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+            inline void append(std::string& out, T part) { out += std::to_string(part); }
+
+            template <typename... Parts>
+            std::string build(Parts&&... parts) {
+                std::string out;
+                (append(out, std::forward<Parts>(parts)), ...);
+                return out;
+            }
+
+            inline std::string build(std::string&& message) { return std::move(message); }
+
+            // Copies `format` up to the next "{}" and steps past it; without one, copies the rest plus a space
+            inline void nextPlaceholder(std::string& out, const char*& format) {
+                const char* placeholder = std::strstr(format, "{}");
+                if (!placeholder) {
+                    out += format;
+                    out += ' ';
+                    format += std::strlen(format);
+                    return;
+                }
+                out.append(format, placeholder);
+                format = placeholder + 2;
+            }
+
+            // Text rendering of an SLOG_* statement when no binary log is open
+            template <typename... Args>
+            std::string substitute(const char* format, const Args&... args) {
+                std::string out;
+                ((nextPlaceholder(out, format), append(out, args)), ...);
+                out += format;
+                return out;
+            }
+        }
+
+        // LAZY LEVEL-FILTERED LOGGING
+        // The arguments are only evaluated (and the message only built) once the
+        // level is known to be enabled. Levels below CRYPTO_MIN_LOG_LEVEL fail a
+        // constant condition, so the whole statement compiles to nothing.
+        #define CRYPTO_LOG(level, ...)                                                            \
+            do {                                                                                  \
+                if (static_cast<int>(level) >= CRYPTO_MIN_LOG_LEVEL) {                           \
+                    Crypto::Utils::Logger* cryptoLogger = Crypto::Utils::Logger::getInstance();   \
+                    if (cryptoLogger->isEnabled(level)) {                                         \
+                        cryptoLogger->log(level, Crypto::Utils::LogFormat::build(__VA_ARGS__));   \
+                    }                                                                             \
+                }                                                                                 \
+            } while (0)
+
+        // STRUCTURED ("{}" FORMAT STRING) LOGGING
+        // The format must be a string literal. With a binary log open the call
+        // site's format is registered once and each statement records only the ID,
+        // a timestamp and the raw arguments; otherwise it renders as text.
+        #define CRYPTO_SLOG(level, ...)                                                                          \
+            do {                                                                                                 \
+                if (static_cast<int>(level) >= CRYPTO_MIN_LOG_LEVEL) {                                          \
+                    Crypto::Utils::Logger* cryptoLogger = Crypto::Utils::Logger::getInstance();                  \
+                    if (cryptoLogger->isEnabled(level)) {                                                        \
+                        static const uint32_t cryptoFormatId =                                                   \
+                            Crypto::Utils::BinaryLog::registerFormat(level, __FILE__, __LINE__, __VA_ARGS__);    \
+                        if (Crypto::Utils::BinaryLog::isOpen()) {                                                \
+                            Crypto::Utils::BinaryLog::write(cryptoFormatId, __VA_ARGS__);                        \
+                        } else {                                                                                 \
+                            cryptoLogger->log(level, Crypto::Utils::LogFormat::substitute(__VA_ARGS__));         \
+                        }                                                                                        \
+                    }                                                                                            \
+                }                                                                                                \
+            } while (0)
+
+        #define SLOG_DEBUG(...) CRYPTO_SLOG(Crypto::Utils::LogLevel::DEBUG, __VA_ARGS__)
+        #define SLOG_INFO(...) CRYPTO_SLOG(Crypto::Utils::LogLevel::INFO, __VA_ARGS__)
+        #define SLOG_WARNING(...) CRYPTO_SLOG(Crypto::Utils::LogLevel::WARNING, __VA_ARGS__)
+        #define SLOG_ERROR(...) CRYPTO_SLOG(Crypto::Utils::LogLevel::ERROR, __VA_ARGS__)
+        #define SLOG_CRITICAL(...) CRYPTO_SLOG(Crypto::Utils::LogLevel::CRITICAL, __VA_ARGS__)
+
+        #define LOG_DEBUG(...) CRYPTO_LOG(Crypto::Utils::LogLevel::DEBUG, __VA_ARGS__)
+        #define LOG_INFO(...) CRYPTO_LOG(Crypto::Utils::LogLevel::INFO, __VA_ARGS__)
+        #define LOG_WARNING(...) CRYPTO_LOG(Crypto::Utils::LogLevel::WARNING, __VA_ARGS__)
+        #define LOG_ERROR(...) CRYPTO_LOG(Crypto::Utils::LogLevel::ERROR, __VA_ARGS__)
+        #define LOG_CRITICAL(...) CRYPTO_LOG(Crypto::Utils::LogLevel::CRITICAL, __VA_ARGS__)
     }
-    
+
 }
 
 #endif // LOGGER_H
@@ -0,0 +1,48 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Crypto {
+    namespace Utils {
+
+        // READ-ONLY MEMORY MAPPING OF A WHOLE FILE (RAII)
+        class MappedFile {
+        public:
+            explicit MappedFile(const std::string& filePath);
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile(MappedFile&& other) noexcept;
+            MappedFile& operator=(MappedFile&& other) noexcept;
+
+            const uint8_t* data() const { return mapping; }
+            size_t size() const { return length; }
+            const char* begin() const { return reinterpret_cast<const char*>(mapping); }
+            const char* end() const { return reinterpret_cast<const char*>(mapping) + length; }
+
+            // Drops resident pages wholly inside [offset, offset + count) once a sequential
+            // reader is past them; reads fault them back in from the file
+            void discard(size_t offset, size_t count) const;
+
+            // STREAM A FILE THROUGH FIXED-SIZE MAPPED WINDOWS
+            // Only one window is mapped at a time, so resident memory stays flat regardless of file size.
+            static void forEachChunk(const std::string& filePath, size_t chunkSize,
+                                     const std::function<void(const uint8_t*, size_t)>& consumer);
+
+            static constexpr size_t DEFAULT_CHUNK_SIZE = 16 * 1024 * 1024;
+
+        private:
+            void release();
+
+            uint8_t* mapping = nullptr;
+            size_t length = 0;
+        };
+    } // namespace Utils
+} // namespace Crypto
+
+#endif
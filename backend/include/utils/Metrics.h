@@ -0,0 +1,229 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace Crypto {
+    namespace Utils {
+
+        // PER-THREAD METRIC CELLS
+        // Every thread owns a slot: a lazily allocated array of cells in which
+        // each counter or histogram has a fixed offset. Only the owner writes a
+        // slot, so an update is a plain relaxed load and store on a cache line no
+        // other thread touches. Slots outlive their threads and are handed to the
+        // next new thread, so totals never go backwards. Threads beyond
+        // MAX_THREAD_SLOTS share one overflow slot updated with atomic RMWs.
+        // Readers merge all slots only when a snapshot is taken.
+        namespace MetricsDetail {
+            constexpr size_t MAX_THREAD_SLOTS = 64;
+            constexpr size_t CELLS_PER_SLOT = 16384;
+
+            struct ThreadCells {
+                std::atomic<uint64_t>* cells = nullptr;
+                bool exclusive = false;
+            };
+
+            // Constant-initialized, so the hot path reads it without a TLS wrapper call
+            inline thread_local ThreadCells* localCells = nullptr;
+
+            // Slow path: binds the calling thread to a slot (or the overflow slot)
+            ThreadCells* claimCells();
+
+            inline ThreadCells& cells() {
+                ThreadCells* local = localCells;
+                return local ? *local : *claimCells();
+            }
+
+            inline void add(size_t offset, uint64_t amount) {
+                ThreadCells& local = cells();
+                std::atomic<uint64_t>& cell = local.cells[offset];
+                if (local.exclusive) {
+                    cell.store(cell.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+                } else {
+                    cell.fetch_add(amount, std::memory_order_relaxed);
+                }
+            }
+
+            inline void raise(size_t offset, uint64_t value) {
+                ThreadCells& local = cells();
+                std::atomic<uint64_t>& cell = local.cells[offset];
+                uint64_t current = cell.load(std::memory_order_relaxed);
+                if (local.exclusive) {
+                    if (value > current) {
+                        cell.store(value, std::memory_order_relaxed);
+                    }
+                    return;
+                }
+                while (value > current && !cell.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                }
+            }
+
+            // Sum of one cell over every slot
+            uint64_t merge(size_t offset);
+            // Largest value of one cell over every slot
+            uint64_t mergeMax(size_t offset);
+        }
+
+        // MONOTONIC COUNTER
+        class Counter {
+        public:
+            void increment() { MetricsDetail::add(offset, 1); }
+            void add(uint64_t amount) { MetricsDetail::add(offset, amount); }
+            // Merged over all threads
+            uint64_t value() const { return MetricsDetail::merge(offset); }
+
+        private:
+            friend class Metrics;
+            explicit Counter(size_t offset) : offset(offset) {}
+
+            size_t offset;
+        };
+
+        // INSTANTANEOUS VALUE (QUEUE DEPTHS, CONFIGURED SIZES); ONE SHARED ATOMIC
+        class Gauge {
+        public:
+            void set(int64_t newValue) { current.store(newValue, std::memory_order_relaxed); }
+            void add(int64_t amount) { current.fetch_add(amount, std::memory_order_relaxed); }
+            void sub(int64_t amount) { current.fetch_sub(amount, std::memory_order_relaxed); }
+            int64_t value() const { return current.load(std::memory_order_relaxed); }
+
+        private:
+            friend class Metrics;
+            Gauge() = default;
+
+            std::atomic<int64_t> current{0};
+        };
+
+        // MERGED VIEW OF A HISTOGRAM
+        struct HistogramSnapshot {
+            uint64_t count = 0;
+            uint64_t sum = 0;
+            uint64_t max = 0;
+            std::vector<uint64_t> buckets;
+
+            // Value at quantile `q` (0..1), accurate to the bucket width (<= 1/16 of the value)
+            uint64_t quantile(double q) const;
+            double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+        };
+
+        // LOG-LINEAR (HDR-STYLE) LATENCY HISTOGRAM IN NANOSECONDS
+        // Each power of two is split into 16 linear sub-buckets, so relative
+        // error stays under 6.25% from 1 ns up to MAX_VALUE (about 68 s); larger
+        // values land in the last bucket. Recording is two cell adds and a max.
+        class Histogram {
+        public:
+            static constexpr unsigned SUB_BITS = 4;
+            static constexpr uint64_t SUB_COUNT = uint64_t(1) << SUB_BITS;
+            static constexpr unsigned MAX_EXPONENT = 36;
+            static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_EXPONENT) - 1;
+            static constexpr size_t BUCKETS = (MAX_EXPONENT - SUB_BITS + 1) * SUB_COUNT;
+            // Buckets, then the sum, then the maximum
+            static constexpr size_t CELLS = BUCKETS + 2;
+
+            static size_t bucketIndex(uint64_t value) {
+                if (value > MAX_VALUE) {
+                    value = MAX_VALUE;
+                }
+                if (value < SUB_COUNT) {
+                    return static_cast<size_t>(value);
+                }
+                unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(value));
+                unsigned shift = exponent - SUB_BITS;
+                return static_cast<size_t>((shift + 1) * SUB_COUNT + ((value >> shift) & (SUB_COUNT - 1)));
+            }
+
+            // Smallest value that falls into bucket `index`
+            static uint64_t bucketLowerBound(size_t index) {
+                size_t block = index / SUB_COUNT;
+                uint64_t sub = index % SUB_COUNT;
+                return block == 0 ? sub : (SUB_COUNT + sub) << (block - 1);
+            }
+
+            static uint64_t bucketWidth(size_t index) {
+                size_t block = index / SUB_COUNT;
+                return block == 0 ? 1 : uint64_t(1) << (block - 1);
+            }
+
+            void record(uint64_t nanoseconds) {
+                MetricsDetail::add(offset + bucketIndex(nanoseconds), 1);
+                MetricsDetail::add(offset + BUCKETS, nanoseconds);
+                MetricsDetail::raise(offset + BUCKETS + 1, nanoseconds);
+            }
+
+            void record(std::chrono::nanoseconds duration) {
+                record(static_cast<uint64_t>(duration.count() > 0 ? duration.count() : 0));
+            }
+
+            HistogramSnapshot snapshot() const;
+
+        private:
+            friend class Metrics;
+            explicit Histogram(size_t offset) : offset(offset) {}
+
+            size_t offset;
+        };
+
+        // RECORDS THE LIFETIME OF A SCOPE INTO A HISTOGRAM
+        class ScopedTimer {
+        public:
+            explicit ScopedTimer(Histogram& histogram)
+                : histogram(histogram), started(std::chrono::steady_clock::now()) {}
+            ~ScopedTimer() { histogram.record(std::chrono::steady_clock::now() - started); }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        private:
+            Histogram& histogram;
+            std::chrono::steady_clock::time_point started;
+        };
+
+        // WHERE A PERIODIC EXPORT GOES
+        struct MetricsExportOptions {
+            std::string prometheusFile;                 // rewritten atomically every `interval`; empty = off
+            std::chrono::seconds interval{15};
+            uint16_t port = 0;                          // HTTP on 127.0.0.1 (/metrics, /metrics.json); 0 = off
+        };
+
+        // METRICS REGISTRY
+        // Metrics are registered once (typically into a function-local static
+        // reference) and live for the whole process. Registering the same name and
+        // labels again returns the existing metric. `labels` is the Prometheus
+        // label body, e.g. `algorithm="sha256"`. Histograms record nanoseconds and
+        // are exported in seconds, so their names should end in `_seconds`.
+        class Metrics {
+        public:
+            using json = nlohmann::json;
+
+            // Throws std::runtime_error when the name is reused with another type or the cell space is exhausted
+            static Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+            static Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+            static Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+            // EXPORT
+            // {"counters": {...}, "gauges": {...}, "histograms": {...}} keyed by `name{labels}`
+            static json snapshot();
+            // snapshot() wrapped in JSONHelper::createSuccessResponse
+            static json snapshotResponse();
+            // Prometheus text exposition format (histograms as summaries)
+            static std::string prometheusText();
+            // Writes prometheusText() to a temporary file and renames it over `filePath`
+            static void writePrometheusFile(const std::string& filePath);
+
+            // Starts (or restarts) the background exporter; throws std::runtime_error if the port cannot be bound
+            static void startExport(const MetricsExportOptions& options);
+            static void stopExport();
+
+            // Applies `metrics.prometheusFile`, `metrics.exportIntervalSeconds` and `metrics.port`
+            static void configure();
+        };
+    } // namespace Utils
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Crypto {
+    namespace Utils {
+
+        // FIXED-SIZE WORKER POOL
+        class ThreadPool {
+        public:
+            explicit ThreadPool(size_t threadCount);
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            size_t size() const { return workerCount.load(std::memory_order_relaxed); }
+
+            // Grows or shrinks the pool without waiting for queued work; retiring
+            // workers leave between tasks. Work queued by parallelFor() is finished
+            // by the caller if no worker is left, but submit() needs at least one.
+            void resize(size_t threadCount);
+
+            // Queue a task and get a future for its result
+            template <typename F>
+            auto submit(F&& task) -> std::future<decltype(task())> {
+                using Result = decltype(task());
+                auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+                std::future<Result> result = packaged->get_future();
+                enqueue([packaged]() { (*packaged)(); });
+                return result;
+            }
+
+            // Split [0, count) into chunks of at least `minChunk` items and run
+            // body(begin, end) on the workers and the calling thread; blocks until
+            // every chunk is done and rethrows the first exception raised.
+            void parallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& body);
+
+            // `mining.threadCount` from the loaded config, or the hardware concurrency when unset
+            static size_t configuredThreadCount();
+
+        private:
+            void enqueue(std::function<void()> task);
+            void workerLoop();
+            // Runs one queued task on the calling thread; false if the queue was empty
+            bool runPending();
+            // Caller holds `resizeMutex`
+            void joinRetired();
+
+            std::mutex resizeMutex;    // guards `workers`
+            std::vector<std::thread> workers;
+            std::atomic<size_t> workerCount{0};
+            std::queue<std::function<void()>> tasks;
+            std::mutex queueMutex;
+            std::condition_variable queueCondition;
+            bool stopping = false;
+            size_t retiring = 0;                        // workers asked to exit, guarded by `queueMutex`
+            std::vector<std::thread::id> retired;       // exited, not yet joined; guarded by `queueMutex`
+        };
+    } // namespace Utils
+} // namespace Crypto
+
+#endif
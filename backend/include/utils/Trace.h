@@ -0,0 +1,129 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <nlohmann/json.hpp>
+
+// CRYPTO_TRACE_SCOPE statements are compiled in only when this is non-zero (CMake option CRYPTO_ENABLE_TRACING)
+#ifndef CRYPTO_ENABLE_TRACING
+#define CRYPTO_ENABLE_TRACING 0
+#endif
+
+namespace Crypto {
+    namespace Utils {
+
+        // ONE COMPLETED SPAN
+        // Names and argument keys must be string literals (only the pointer is kept).
+        struct TraceEvent {
+            static constexpr size_t MAX_ARGS = 2;
+
+            const char* name = nullptr;
+            uint64_t begin = 0;    // steady-clock nanoseconds
+            uint64_t end = 0;
+            uint8_t argCount = 0;
+            const char* argNames[MAX_ARGS] = {};
+            int64_t argValues[MAX_ARGS] = {};
+        };
+
+        // SPAN RECORDER
+        // Each thread appends finished spans to its own preallocated buffer under
+        // an uncontended spin flag; when the buffer is full further spans are
+        // counted and dropped rather than allocating on the hot path. Buffers are
+        // only walked by toJSON() / dump(). When a thread exits, its spans are
+        // copied out (trimmed) for export and its buffer goes to the next thread
+        // that traces, so buffer memory follows the peak number of concurrently
+        // tracing threads rather than every thread that ever traced.
+        class Trace {
+        public:
+            using json = nlohmann::json;
+
+            static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 65536;
+
+            // Begins recording; buffers of threads that already traced keep their capacity
+            static void start(size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+            static void stop();
+            static bool isRecording() { return recording.load(std::memory_order_relaxed); }
+            // Discards every recorded span
+            static void clear();
+            // Spans lost to full thread buffers (or closed after their thread exited) since start()
+            static uint64_t droppedCount();
+
+            // Chrome / Perfetto trace-event JSON: complete ("X") events plus thread names
+            static json toJSON();
+            // Writes toJSON() with JSONHelper::saveToFile
+            static void dump(const std::string& filePath);
+
+            // Applies `tracing.enabled`, `tracing.outputPath` and `tracing.eventsPerThread`
+            static void configure();
+            // Stops recording and dumps to `tracing.outputPath` if configure() started a trace
+            static void finish();
+
+            // Used by TraceScope
+            static uint64_t now();
+            static void record(const TraceEvent& event);
+
+        private:
+            static std::atomic<bool> recording;
+        };
+
+        // RAII SPAN: TIMES ITS OWN LIFETIME
+        class TraceScope {
+        public:
+            explicit TraceScope(const char* name) {
+                if (Trace::isRecording()) {
+                    event.name = name;
+                    event.begin = Trace::now();
+                }
+            }
+
+            TraceScope(const char* name, const char* key, int64_t value) : TraceScope(name) { arg(key, value); }
+
+            TraceScope(const char* name, const char* key1, int64_t value1, const char* key2, int64_t value2)
+                : TraceScope(name) {
+                arg(key1, value1);
+                arg(key2, value2);
+            }
+
+            ~TraceScope() {
+                if (event.name) {
+                    event.end = Trace::now();
+                    Trace::record(event);
+                }
+            }
+
+            TraceScope(const TraceScope&) = delete;
+            TraceScope& operator=(const TraceScope&) = delete;
+
+            // Attaches a value known only partway through the span; extra arguments beyond MAX_ARGS are ignored
+            void arg(const char* key, int64_t value) {
+                if (event.name && event.argCount < TraceEvent::MAX_ARGS) {
+                    event.argNames[event.argCount] = key;
+                    event.argValues[event.argCount] = value;
+                    ++event.argCount;
+                }
+            }
+
+        private:
+            TraceEvent event;
+        };
+
+        // INSTRUMENTATION MACROS
+        // CRYPTO_TRACE_SCOPE("name") or CRYPTO_TRACE_SCOPE("name", "key", value[, "key", value])
+        // opens a span until the end of the enclosing block. With tracing
+        // disabled the arguments are not evaluated and nothing is emitted.
+        #define CRYPTO_TRACE_CONCAT_INNER(a, b) a##b
+        #define CRYPTO_TRACE_CONCAT(a, b) CRYPTO_TRACE_CONCAT_INNER(a, b)
+
+        #if CRYPTO_ENABLE_TRACING
+        #define CRYPTO_TRACE_SCOPE(...) \
+            Crypto::Utils::TraceScope CRYPTO_TRACE_CONCAT(cryptoTraceScope, __LINE__)(__VA_ARGS__)
+        #else
+        #define CRYPTO_TRACE_SCOPE(...) static_cast<void>(0)
+        #endif
+    } // namespace Utils
+} // namespace Crypto
+
+#endif
@@ -0,0 +1,262 @@
+#include "crypto/base58.h"
+#include "crypto/hash.h"
+#include "crypto/sha256_transform.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            const char ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+            // Character -> digit, -1 outside the alphabet
+            struct DigitTable {
+                int8_t digit[256];
+                DigitTable() {
+                    std::memset(digit, -1, sizeof(digit));
+                    for (int i = 0; i < 58; ++i) {
+                        digit[static_cast<uint8_t>(ALPHABET[i])] = static_cast<int8_t>(i);
+                    }
+                }
+            };
+
+            const DigitTable DIGITS;
+
+            constexpr uint64_t LIMB_BASE = 656356768;    // 58^5
+            constexpr size_t LIMB_DIGITS = 5;
+            constexpr size_t STACK_LIMBS = 64;           // inputs up to ~230 bytes need no heap
+
+            const uint32_t POWERS_OF_58[LIMB_DIGITS + 1] = {1, 58, 3364, 195112, 11316496, 656356768};
+
+            // Limb scratch space on the stack, spilling to the heap only for unusually long inputs
+            class LimbBuffer {
+            public:
+                explicit LimbBuffer(size_t count) {
+                    limbs = count <= STACK_LIMBS ? local : (heap.resize(count), heap.data());
+                    std::memset(limbs, 0, count * sizeof(uint32_t));
+                }
+                uint32_t* data() { return limbs; }
+
+            private:
+                uint32_t local[STACK_LIMBS];
+                std::vector<uint32_t> heap;
+                uint32_t* limbs;
+            };
+
+            constexpr size_t ADDRESS_PAYLOAD = 1 + Digest160::SIZE;
+            constexpr size_t ADDRESS_BYTES = ADDRESS_PAYLOAD + 4;
+            constexpr size_t BATCH_CHUNK = 64;
+        }
+
+        size_t Base58::encode(ByteView data, char* out) {
+            const uint8_t* bytes = data.data();
+            size_t length = data.size();
+
+            size_t zeros = 0;
+            while (zeros < length && bytes[zeros] == 0) {
+                ++zeros;
+            }
+
+            // Little-endian base 58^5 limbs; `used` grows as the value does
+            size_t capacity = (maxEncodedLength(length) + LIMB_DIGITS - 1) / LIMB_DIGITS + 1;
+            LimbBuffer buffer(capacity);
+            uint32_t* limbs = buffer.data();
+            size_t used = 0;
+
+            // Feed the binary value in big-endian 32-bit words (a short first word carries the remainder)
+            size_t position = zeros;
+            size_t head = (length - zeros) % 4;
+            while (position < length) {
+                size_t take = head ? head : 4;
+                head = 0;
+                uint64_t carry = 0;
+                for (size_t i = 0; i < take; ++i) {
+                    carry = (carry << 8) | bytes[position + i];
+                }
+                position += take;
+
+                unsigned shift = static_cast<unsigned>(8 * take);
+                for (size_t i = 0; i < used; ++i) {
+                    uint64_t value = (static_cast<uint64_t>(limbs[i]) << shift) + carry;
+                    limbs[i] = static_cast<uint32_t>(value % LIMB_BASE);
+                    carry = value / LIMB_BASE;
+                }
+                while (carry) {
+                    limbs[used++] = static_cast<uint32_t>(carry % LIMB_BASE);
+                    carry /= LIMB_BASE;
+                }
+            }
+
+            size_t written = 0;
+            for (size_t i = 0; i < zeros; ++i) {
+                out[written++] = '1';
+            }
+            if (used == 0) {
+                return written;
+            }
+
+            // The most significant limb drops its leading zero digits; the rest print all five
+            char digits[LIMB_DIGITS];
+            uint32_t top = limbs[used - 1];
+            size_t count = 0;
+            while (top) {
+                digits[count++] = ALPHABET[top % 58];
+                top /= 58;
+            }
+            while (count) {
+                out[written++] = digits[--count];
+            }
+            for (size_t i = used - 1; i-- > 0;) {
+                uint32_t limb = limbs[i];
+                for (size_t d = LIMB_DIGITS; d-- > 0;) {
+                    out[written + d] = ALPHABET[limb % 58];
+                    limb /= 58;
+                }
+                written += LIMB_DIGITS;
+            }
+            return written;
+        }
+
+        std::string Base58::encode(ByteView data) {
+            std::string out(maxEncodedLength(data.size()), '\0');
+            out.resize(encode(data, &out[0]));
+            return out;
+        }
+
+        std::vector<uint8_t> Base58::decode(const std::string& text) {
+            size_t length = text.size();
+            size_t ones = 0;
+            while (ones < length && text[ones] == '1') {
+                ++ones;
+            }
+
+            // Little-endian base 2^32 words (log(58) / log(256) < 0.733)
+            size_t capacity = ((length - ones) * 733 / 1000 + 1 + 3) / 4 + 1;
+            LimbBuffer buffer(capacity);
+            uint32_t* words = buffer.data();
+            size_t used = 0;
+
+            size_t position = ones;
+            size_t head = (length - ones) % LIMB_DIGITS;
+            while (position < length) {
+                size_t take = head ? head : LIMB_DIGITS;
+                head = 0;
+                uint64_t carry = 0;
+                for (size_t i = 0; i < take; ++i) {
+                    int8_t digit = DIGITS.digit[static_cast<uint8_t>(text[position + i])];
+                    if (digit < 0) {
+                        throw std::invalid_argument("Invalid Base58 character at offset " + std::to_string(position + i));
+                    }
+                    carry = carry * 58 + static_cast<uint64_t>(digit);
+                }
+                position += take;
+
+                uint64_t multiplier = POWERS_OF_58[take];
+                for (size_t i = 0; i < used; ++i) {
+                    uint64_t value = static_cast<uint64_t>(words[i]) * multiplier + carry;
+                    words[i] = static_cast<uint32_t>(value);
+                    carry = value >> 32;
+                }
+                while (carry) {
+                    words[used++] = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+            }
+
+            std::vector<uint8_t> out(ones, 0);
+            out.reserve(ones + 4 * used);
+            bool leading = true;
+            for (size_t i = used; i-- > 0;) {
+                for (int shift = 24; shift >= 0; shift -= 8) {
+                    uint8_t byte = static_cast<uint8_t>(words[i] >> shift);
+                    if (leading && byte == 0) {
+                        continue;
+                    }
+                    leading = false;
+                    out.push_back(byte);
+                }
+            }
+            return out;
+        }
+
+        std::string Base58::encodeCheck(ByteView payload) {
+            std::vector<uint8_t> data(payload.begin(), payload.end());
+            Digest256 checksum = Hash::sha256dRaw(payload);
+            data.insert(data.end(), checksum.begin(), checksum.begin() + 4);
+            return encode(data);
+        }
+
+        std::vector<uint8_t> Base58::decodeCheck(const std::string& text) {
+            std::vector<uint8_t> data = decode(text);
+            if (data.size() < 4) {
+                throw std::invalid_argument("Base58Check input is shorter than its checksum");
+            }
+            size_t payload = data.size() - 4;
+            Digest256 checksum = Hash::sha256dRaw(data.data(), payload);
+            if (std::memcmp(checksum.data(), data.data() + payload, 4) != 0) {
+                throw std::invalid_argument("Base58Check checksum mismatch");
+            }
+            data.resize(payload);
+            return data;
+        }
+
+        std::string Base58::encodeAddress(uint8_t version, const Digest160& hash) {
+            uint8_t raw[ADDRESS_BYTES];
+            raw[0] = version;
+            std::memcpy(raw + 1, hash.data(), Digest160::SIZE);
+            Digest256 checksum = Hash::sha256dRaw(raw, ADDRESS_PAYLOAD);
+            std::memcpy(raw + ADDRESS_PAYLOAD, checksum.data(), 4);
+
+            char text[ADDRESS_TEXT_SIZE];
+            return std::string(text, encode(ByteView(raw, ADDRESS_BYTES), text));
+        }
+
+        void Base58::encodeAddressBatch(uint8_t version, const Digest160* hashes, size_t count, char (*out)[ADDRESS_TEXT_SIZE]) {
+            // Fixed stack chunks: the checksum lanes see BATCH_CHUNK payloads at a time, nothing touches the heap
+            uint8_t raw[BATCH_CHUNK][ADDRESS_BYTES];
+            ByteView payloads[BATCH_CHUNK];
+            Digest256 checksums[BATCH_CHUNK];
+            bool lanes = Transform::laneWidth() > 1;
+
+            for (size_t start = 0; start < count; start += BATCH_CHUNK) {
+                size_t chunk = std::min(BATCH_CHUNK, count - start);
+                for (size_t i = 0; i < chunk; ++i) {
+                    raw[i][0] = version;
+                    std::memcpy(raw[i] + 1, hashes[start + i].data(), Digest160::SIZE);
+                    payloads[i] = ByteView(raw[i], ADDRESS_PAYLOAD);
+                }
+                if (lanes) {
+                    Hash::sha256dBatch(payloads, checksums, chunk);
+                } else {
+                    // A single SHA-NI stream outruns the vector lanes
+                    for (size_t i = 0; i < chunk; ++i) {
+                        checksums[i] = Hash::sha256dRaw(payloads[i]);
+                    }
+                }
+                for (size_t i = 0; i < chunk; ++i) {
+                    std::memcpy(raw[i] + ADDRESS_PAYLOAD, checksums[i].data(), 4);
+                    char* text = out[start + i];
+                    text[encode(ByteView(raw[i], ADDRESS_BYTES), text)] = '\0';
+                }
+            }
+        }
+
+        std::vector<std::string> Base58::encodeAddressBatch(uint8_t version, const Digest160* hashes, size_t count) {
+            std::vector<std::string> addresses;
+            addresses.reserve(count);
+            char text[BATCH_CHUNK][ADDRESS_TEXT_SIZE];
+            for (size_t start = 0; start < count; start += BATCH_CHUNK) {
+                size_t chunk = std::min(BATCH_CHUNK, count - start);
+                encodeAddressBatch(version, hashes + start, chunk, text);
+                for (size_t i = 0; i < chunk; ++i) {
+                    addresses.emplace_back(text[i]);
+                }
+            }
+            return addresses;
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
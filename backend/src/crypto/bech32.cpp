@@ -0,0 +1,264 @@
+#include "crypto/bech32.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            const char CHARSET[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+            const uint32_t GENERATOR[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd, 0x2a1462b3};
+            const uint32_t BECH32M_CONSTANT = 0x2bc830a3;
+            const size_t CHECKSUM_LENGTH = 6;
+
+            struct Tables {
+                uint32_t generator[32];    // XOR of the generator terms selected by the 5 bits shifted out
+                int8_t value[128];         // lowercase character -> 5-bit value, -1 otherwise
+                Tables() {
+                    for (uint32_t top = 0; top < 32; ++top) {
+                        generator[top] = 0;
+                        for (int i = 0; i < 5; ++i) {
+                            if ((top >> i) & 1) {
+                                generator[top] ^= GENERATOR[i];
+                            }
+                        }
+                    }
+                    std::memset(value, -1, sizeof(value));
+                    for (int i = 0; i < 32; ++i) {
+                        value[static_cast<uint8_t>(CHARSET[i])] = static_cast<int8_t>(i);
+                    }
+                }
+            };
+
+            const Tables TABLES;
+
+            inline uint32_t polymodStep(uint32_t checksum, uint8_t value) {
+                uint32_t top = checksum >> 25;
+                return (((checksum & 0x1ffffff) << 5) ^ value) ^ TABLES.generator[top];
+            }
+
+            inline uint32_t finalConstant(Bech32::Encoding encoding) {
+                return encoding == Bech32::Encoding::BECH32 ? 1 : BECH32M_CONSTANT;
+            }
+
+            void validateHrp(const std::string& hrp) {
+                if (hrp.empty() || hrp.size() > 83) {
+                    throw std::invalid_argument("Bech32 human-readable part must be 1 to 83 characters");
+                }
+                for (char c : hrp) {
+                    if (c < 33 || c > 126 || (c >= 'A' && c <= 'Z')) {
+                        throw std::invalid_argument("Bech32 human-readable part must be lowercase printable ASCII");
+                    }
+                }
+            }
+
+            // Checksum state after the expanded human-readable part
+            uint32_t hrpState(const std::string& hrp) {
+                uint32_t checksum = 1;
+                for (char c : hrp) {
+                    checksum = polymodStep(checksum, static_cast<uint8_t>(c) >> 5);
+                }
+                checksum = polymodStep(checksum, 0);
+                for (char c : hrp) {
+                    checksum = polymodStep(checksum, static_cast<uint8_t>(c) & 31);
+                }
+                return checksum;
+            }
+
+            // Writes hrp '1' data checksum into `out`; returns the length
+            size_t encodeInto(const std::string& hrp, uint32_t prefixState, const uint8_t* values, size_t count,
+                              Bech32::Encoding encoding, char* out) {
+                size_t written = hrp.size();
+                std::memcpy(out, hrp.data(), written);
+                out[written++] = '1';
+
+                uint32_t checksum = prefixState;
+                for (size_t i = 0; i < count; ++i) {
+                    checksum = polymodStep(checksum, values[i]);
+                    out[written++] = CHARSET[values[i]];
+                }
+                for (size_t i = 0; i < CHECKSUM_LENGTH; ++i) {
+                    checksum = polymodStep(checksum, 0);
+                }
+                checksum ^= finalConstant(encoding);
+                for (size_t i = 0; i < CHECKSUM_LENGTH; ++i) {
+                    out[written++] = CHARSET[(checksum >> (5 * (5 - i))) & 31];
+                }
+                return written;
+            }
+
+            // Regroup bits; 8 -> 5 pads the tail, 5 -> 8 rejects non-zero or overlong padding
+            template <int FROM, int TO, bool PAD>
+            bool convertBits(const uint8_t* in, size_t length, uint8_t* out, size_t& written) {
+                const uint32_t mask = (1u << TO) - 1;
+                uint32_t accumulator = 0;
+                int bits = 0;
+                written = 0;
+                for (size_t i = 0; i < length; ++i) {
+                    accumulator = (accumulator << FROM) | in[i];
+                    bits += FROM;
+                    while (bits >= TO) {
+                        bits -= TO;
+                        out[written++] = static_cast<uint8_t>((accumulator >> bits) & mask);
+                    }
+                }
+                if (PAD) {
+                    if (bits) {
+                        out[written++] = static_cast<uint8_t>((accumulator << (TO - bits)) & mask);
+                    }
+                    return true;
+                }
+                return bits < FROM && ((accumulator << (TO - bits)) & mask) == 0;
+            }
+
+            Bech32::Encoding segwitEncoding(int version) {
+                if (version < 0 || version > 16) {
+                    throw std::invalid_argument("Witness version must be between 0 and 16");
+                }
+                return version == 0 ? Bech32::Encoding::BECH32 : Bech32::Encoding::BECH32M;
+            }
+
+            void validateProgram(int version, size_t length) {
+                if (length < 2 || length > 40) {
+                    throw std::invalid_argument("Witness program must be 2 to 40 bytes");
+                }
+                if (version == 0 && length != 20 && length != 32) {
+                    throw std::invalid_argument("Version 0 witness program must be 20 or 32 bytes");
+                }
+            }
+
+            // Version value followed by the program regrouped into 5-bit values
+            size_t segwitValues(int version, const uint8_t* program, size_t length, uint8_t* values) {
+                size_t written = 0;
+                values[0] = static_cast<uint8_t>(version);
+                convertBits<8, 5, true>(program, length, values + 1, written);
+                return written + 1;
+            }
+
+            template <size_t N>
+            std::vector<std::string> encodeProgramBatch(const std::string& hrp, int version, const Digest<N>* programs, size_t count) {
+                validateHrp(hrp);
+                Bech32::Encoding encoding = segwitEncoding(version);
+                validateProgram(version, N);
+                if (hrp.size() + 1 + 1 + (8 * N + 4) / 5 + CHECKSUM_LENGTH > Bech32::MAX_LENGTH) {
+                    throw std::invalid_argument("Bech32 string would exceed 90 characters");
+                }
+
+                uint32_t prefix = hrpState(hrp);
+                std::vector<std::string> addresses(count);
+                uint8_t values[1 + (8 * N + 4) / 5];
+                char text[Bech32::MAX_LENGTH];
+                for (size_t i = 0; i < count; ++i) {
+                    size_t valueCount = segwitValues(version, programs[i].data(), N, values);
+                    addresses[i].assign(text, encodeInto(hrp, prefix, values, valueCount, encoding, text));
+                }
+                return addresses;
+            }
+        }
+
+        std::string Bech32::encode(const std::string& hrp, const uint8_t* values, size_t count, Encoding encoding) {
+            validateHrp(hrp);
+            if (hrp.size() + 1 + count + CHECKSUM_LENGTH > MAX_LENGTH) {
+                throw std::invalid_argument("Bech32 string would exceed 90 characters");
+            }
+            for (size_t i = 0; i < count; ++i) {
+                if (values[i] > 31) {
+                    throw std::invalid_argument("Bech32 data values must be 5-bit");
+                }
+            }
+            char text[MAX_LENGTH];
+            return std::string(text, encodeInto(hrp, hrpState(hrp), values, count, encoding, text));
+        }
+
+        Bech32::Decoded Bech32::decode(const std::string& text) {
+            if (text.size() > MAX_LENGTH) {
+                throw std::invalid_argument("Bech32 string exceeds 90 characters");
+            }
+            bool lower = false;
+            bool upper = false;
+            std::string normalized(text);
+            for (char& c : normalized) {
+                if (c < 33 || c > 126) {
+                    throw std::invalid_argument("Bech32 string contains a non-printable character");
+                }
+                if (c >= 'a' && c <= 'z') lower = true;
+                if (c >= 'A' && c <= 'Z') {
+                    upper = true;
+                    c = static_cast<char>(c - 'A' + 'a');
+                }
+            }
+            if (lower && upper) {
+                throw std::invalid_argument("Bech32 string mixes upper and lower case");
+            }
+
+            size_t separator = normalized.rfind('1');
+            if (separator == std::string::npos || separator == 0 || separator + 1 + CHECKSUM_LENGTH > normalized.size()) {
+                throw std::invalid_argument("Bech32 separator missing or checksum too short");
+            }
+
+            Decoded decoded;
+            decoded.hrp = normalized.substr(0, separator);
+            uint32_t checksum = hrpState(decoded.hrp);
+            for (size_t i = separator + 1; i < normalized.size(); ++i) {
+                int8_t value = TABLES.value[static_cast<uint8_t>(normalized[i])];
+                if (value < 0) {
+                    throw std::invalid_argument("Invalid Bech32 character at offset " + std::to_string(i));
+                }
+                checksum = polymodStep(checksum, static_cast<uint8_t>(value));
+                decoded.values.push_back(static_cast<uint8_t>(value));
+            }
+
+            if (checksum == 1) {
+                decoded.encoding = Encoding::BECH32;
+            } else if (checksum == BECH32M_CONSTANT) {
+                decoded.encoding = Encoding::BECH32M;
+            } else {
+                throw std::invalid_argument("Bech32 checksum mismatch");
+            }
+            decoded.values.resize(decoded.values.size() - CHECKSUM_LENGTH);
+            return decoded;
+        }
+
+        std::string Bech32::encodeSegwit(const std::string& hrp, int version, ByteView program) {
+            Encoding encoding = segwitEncoding(version);
+            validateProgram(version, program.size());
+            uint8_t values[1 + (8 * 40 + 4) / 5];
+            size_t count = segwitValues(version, program.data(), program.size(), values);
+            return encode(hrp, values, count, encoding);
+        }
+
+        Bech32::SegwitProgram Bech32::decodeSegwit(const std::string& hrp, const std::string& address) {
+            Decoded decoded = decode(address);
+            if (decoded.hrp != hrp) {
+                throw std::invalid_argument("Segwit address has human-readable part '" + decoded.hrp + "', expected '" + hrp + "'");
+            }
+            if (decoded.values.empty()) {
+                throw std::invalid_argument("Segwit address has no witness version");
+            }
+
+            SegwitProgram result;
+            result.version = decoded.values[0];
+            if (segwitEncoding(result.version) != decoded.encoding) {
+                throw std::invalid_argument("Segwit address uses the wrong checksum variant for its version");
+            }
+            result.program.resize(decoded.values.size() * 5 / 8);
+            size_t written = 0;
+            if (!convertBits<5, 8, false>(decoded.values.data() + 1, decoded.values.size() - 1, result.program.data(), written)) {
+                throw std::invalid_argument("Segwit program has invalid padding");
+            }
+            result.program.resize(written);
+            validateProgram(result.version, written);
+            return result;
+        }
+
+        std::vector<std::string> Bech32::encodeSegwitBatch(const std::string& hrp, int version, const Digest160* programs, size_t count) {
+            return encodeProgramBatch(hrp, version, programs, count);
+        }
+
+        std::vector<std::string> Bech32::encodeSegwitBatch(const std::string& hrp, int version, const Digest256* programs, size_t count) {
+            return encodeProgramBatch(hrp, version, programs, count);
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
@@ -0,0 +1,44 @@
+#include "crypto/cpu_features.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            CpuFeatures probe() {
+                CpuFeatures features;
+#if defined(__x86_64__) || defined(__i386__)
+                unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+                if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+                    return features;
+                }
+                features.ssse3 = (ecx & (1u << 9)) != 0;
+                features.sse41 = (ecx & (1u << 19)) != 0;
+
+                // AVX state must also be enabled by the OS (OSXSAVE + XCR0 bits 1 and 2)
+                bool osAvx = false;
+                if ((ecx & (1u << 27)) && (ecx & (1u << 28))) {
+                    unsigned int xcr0Low = 0, xcr0High = 0;
+                    __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+                    osAvx = (xcr0Low & 0x6) == 0x6;
+                }
+
+                if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+                    features.avx2 = osAvx && (ebx & (1u << 5)) != 0;
+                    features.shaNi = features.sse41 && (ebx & (1u << 29)) != 0;
+                }
+#endif
+                return features;
+            }
+        }
+
+        const CpuFeatures& CpuFeatures::get() {
+            static const CpuFeatures features = probe();
+            return features;
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
@@ -0,0 +1,333 @@
+#include "crypto/gcs.h"
+#include "crypto/hash.h"
+#include "crypto/siphash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            // Uniform map of a 64-bit hash into [0, range) without division; monotonic in `hash`
+            inline uint64_t fastRange(uint64_t hash, uint64_t range) {
+                return static_cast<uint64_t>((static_cast<unsigned __int128>(hash) * range) >> 64);
+            }
+
+            void writeCompactSize(std::vector<uint8_t>& out, uint64_t value) {
+                int width = 0;
+                if (value < 0xfd) {
+                    out.push_back(static_cast<uint8_t>(value));
+                    return;
+                } else if (value <= 0xffff) {
+                    out.push_back(0xfd);
+                    width = 2;
+                } else if (value <= 0xffffffff) {
+                    out.push_back(0xfe);
+                    width = 4;
+                } else {
+                    out.push_back(0xff);
+                    width = 8;
+                }
+                for (int i = 0; i < width; ++i) {
+                    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+                }
+            }
+
+            // Returns the number of prefix bytes consumed
+            size_t readCompactSize(const std::vector<uint8_t>& in, uint64_t& value) {
+                if (in.empty()) {
+                    throw std::invalid_argument("GCS filter is empty");
+                }
+                size_t width = in[0] < 0xfd ? 0 : in[0] == 0xfd ? 2 : in[0] == 0xfe ? 4 : 8;
+                if (width == 0) {
+                    value = in[0];
+                    return 1;
+                }
+                if (in.size() < 1 + width) {
+                    throw std::invalid_argument("GCS filter element count is truncated");
+                }
+                value = 0;
+                for (size_t i = 0; i < width; ++i) {
+                    value |= static_cast<uint64_t>(in[1 + i]) << (8 * i);
+                }
+                if (value < (width == 2 ? 0xfdu : width == 4 ? 0x10000u : 0x100000000ull)) {
+                    throw std::invalid_argument("GCS filter element count is not canonically encoded");
+                }
+                return 1 + width;
+            }
+        }
+
+        // ---------------------------------------------------------------
+        // BIT STREAMS
+        // ---------------------------------------------------------------
+
+        void BitStreamWriter::write(uint64_t value, int count) {
+            // At most 32 bits per step keeps the accumulator (<= 7 pending bits) from overflowing
+            while (count > 0) {
+                int step = std::min(count, 32);
+                count -= step;
+                uint64_t chunk = (value >> count) & ((uint64_t(1) << step) - 1);
+                accumulator = (accumulator << step) | chunk;
+                pending += step;
+                while (pending >= 8) {
+                    pending -= 8;
+                    out.push_back(static_cast<uint8_t>(accumulator >> pending));
+                }
+            }
+        }
+
+        void BitStreamWriter::writeUnary(uint64_t count) {
+            while (count >= 32) {
+                write(0xffffffff, 32);
+                count -= 32;
+            }
+            // `count` ones then the terminating zero in a single write
+            write(((uint64_t(1) << count) - 1) << 1, static_cast<int>(count) + 1);
+        }
+
+        void BitStreamWriter::flush() {
+            if (pending) {
+                out.push_back(static_cast<uint8_t>(accumulator << (8 - pending)));
+                pending = 0;
+            }
+            accumulator = 0;
+        }
+
+        void BitStreamReader::refill() {
+            if (position + 8 <= length) {
+                // Whole bytes only: top up to 57-64 valid bits with one big-endian load
+                uint64_t word;
+                std::memcpy(&word, data + position, 8);
+                buffer |= __builtin_bswap64(word) >> available;
+                position += static_cast<size_t>(63 - available) >> 3;
+                available |= 56;
+                return;
+            }
+            while (available <= 56 && position < length) {
+                buffer |= static_cast<uint64_t>(data[position++]) << (56 - available);
+                available += 8;
+            }
+        }
+
+        void BitStreamReader::consume(int count) {
+            buffer = count == 64 ? 0 : buffer << count;
+            available -= count;
+        }
+
+        uint64_t BitStreamReader::read(int count) {
+            if (count == 0) {
+                return 0;
+            }
+            if (count > available) {
+                refill();
+            }
+            if (count <= available) {
+                uint64_t value = buffer >> (64 - count);
+                consume(count);
+                return value;
+            }
+            // Wider than the 57 bits a refill guarantees: split in two
+            if (count > 32 && position < length) {
+                uint64_t high = read(count - 32);
+                return (high << 32) | read(32);
+            }
+            throw std::out_of_range("GCS bit stream exhausted");
+        }
+
+        uint64_t BitStreamReader::readGolombRice(int p) {
+            // Topping up unconditionally is cheaper than a hard-to-predict "buffer low?" branch
+            refill();
+            // Fast path: quotient, stop bit and remainder all sit in the buffer
+            int run = ~buffer ? __builtin_clzll(~buffer) : 64;
+            if (run + 1 + p <= available) {
+                consume(run + 1);
+                uint64_t remainder = p ? buffer >> (64 - p) : 0;
+                consume(p);
+                return (static_cast<uint64_t>(run) << p) | remainder;
+            }
+            uint64_t quotient = readUnary();
+            return (quotient << p) | read(p);
+        }
+
+        uint64_t BitStreamReader::readUnary() {
+            uint64_t ones = 0;
+            for (;;) {
+                if (available == 0) {
+                    refill();
+                    if (available == 0) {
+                        throw std::out_of_range("GCS bit stream exhausted");
+                    }
+                }
+                uint64_t inverted = ~buffer;
+                int run = inverted ? __builtin_clzll(inverted) : 64;
+                if (run < available) {
+                    consume(run + 1);
+                    return ones + static_cast<uint64_t>(run);
+                }
+                ones += static_cast<uint64_t>(available);
+                consume(available);
+            }
+        }
+
+        // ---------------------------------------------------------------
+        // GOLOMB-CODED SET
+        // ---------------------------------------------------------------
+
+        GolombCodedSet::GolombCodedSet(const Params& params, const ByteView* elements, size_t elementCount)
+            : params(params) {
+            // Sort by raw SipHash: equal elements collide here, and because the range map is
+            // monotonic the same order holds after reduction, so one sort serves both steps
+            SipHasher hasher(params.k0, params.k1);
+            std::vector<std::pair<uint64_t, uint32_t>> hashed(elementCount);
+            for (size_t i = 0; i < elementCount; ++i) {
+                hashed[i] = {hasher(elements[i]), static_cast<uint32_t>(i)};
+            }
+            std::sort(hashed.begin(), hashed.end());
+
+            size_t unique = 0;
+            for (size_t i = 0; i < hashed.size(); ++i) {
+                bool duplicate = false;
+                for (size_t j = unique; j-- > 0 && hashed[j].first == hashed[i].first;) {
+                    const ByteView& a = elements[hashed[j].second];
+                    const ByteView& b = elements[hashed[i].second];
+                    if (a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+                if (!duplicate) {
+                    hashed[unique++] = hashed[i];
+                }
+            }
+            count = unique;
+
+            writeCompactSize(bytes, count);
+            headerSize = bytes.size();
+            // Each value costs P + 1 bits plus about one more for the unary quotient
+            bytes.reserve(headerSize + (count * static_cast<uint64_t>(params.p + 2) + 7) / 8);
+
+            BitStreamWriter writer(bytes);
+            uint64_t rangeSize = range();
+            uint64_t previous = 0;
+            for (size_t i = 0; i < unique; ++i) {
+                uint64_t value = fastRange(hashed[i].first, rangeSize);
+                uint64_t delta = value - previous;
+                writer.writeUnary(delta >> params.p);
+                writer.write(delta, params.p);
+                previous = value;
+            }
+            writer.flush();
+        }
+
+        GolombCodedSet::GolombCodedSet(const Params& params, const std::vector<ByteView>& elements)
+            : GolombCodedSet(params, elements.data(), elements.size()) {}
+
+        GolombCodedSet::GolombCodedSet(const Params& params, std::vector<uint8_t> encoded)
+            : params(params), bytes(std::move(encoded)) {
+            headerSize = readCompactSize(bytes, count);
+            if (count > 0xffffffffull) {
+                throw std::invalid_argument("GCS filter element count exceeds 2^32 - 1");
+            }
+        }
+
+        std::vector<uint64_t> GolombCodedSet::hashQueries(const ByteView* elements, size_t elementCount) const {
+            SipHasher hasher(params.k0, params.k1);
+            uint64_t rangeSize = range();
+            std::vector<uint64_t> queries(elementCount);
+            for (size_t i = 0; i < elementCount; ++i) {
+                queries[i] = fastRange(hasher(elements[i]), rangeSize);
+            }
+            std::sort(queries.begin(), queries.end());
+            return queries;
+        }
+
+        // Sorted merge: both sides ascend, so each step advances whichever is behind
+        bool GolombCodedSet::matchSorted(const std::vector<uint64_t>& queries) const {
+            if (count == 0 || queries.empty()) {
+                return false;
+            }
+            BitStreamReader reader(bytes.data() + headerSize, bytes.size() - headerSize);
+            uint64_t value = 0;
+            size_t next = 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                value += reader.readGolombRice(params.p);
+                while (queries[next] < value) {
+                    if (++next == queries.size()) {
+                        return false;
+                    }
+                }
+                if (queries[next] == value) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool GolombCodedSet::match(ByteView element) const {
+            return matchAny(&element, 1);
+        }
+
+        bool GolombCodedSet::matchAny(const ByteView* elements, size_t elementCount) const {
+            return matchSorted(hashQueries(elements, elementCount));
+        }
+
+        bool GolombCodedSet::matchAny(const std::vector<ByteView>& elements) const {
+            return matchAny(elements.data(), elements.size());
+        }
+
+        std::vector<uint64_t> GolombCodedSet::decode() const {
+            std::vector<uint64_t> values;
+            values.reserve(count);
+            BitStreamReader reader(bytes.data() + headerSize, bytes.size() - headerSize);
+            uint64_t value = 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                value += reader.readGolombRice(params.p);
+                values.push_back(value);
+            }
+            return values;
+        }
+
+        // ---------------------------------------------------------------
+        // BIP158 BASIC FILTER
+        // ---------------------------------------------------------------
+
+        GolombCodedSet::Params BlockFilter::basicParams(const Digest256& blockHash) {
+            GolombCodedSet::Params params;
+            for (int i = 7; i >= 0; --i) {
+                params.k0 = (params.k0 << 8) | blockHash[i];
+                params.k1 = (params.k1 << 8) | blockHash[8 + i];
+            }
+            params.p = BASIC_P;
+            params.m = BASIC_M;
+            return params;
+        }
+
+        GolombCodedSet BlockFilter::build(const Digest256& blockHash, const std::vector<ByteView>& scripts) {
+            // Empty scripts are excluded from the basic filter
+            std::vector<ByteView> elements;
+            elements.reserve(scripts.size());
+            for (const ByteView& script : scripts) {
+                if (script.size()) {
+                    elements.push_back(script);
+                }
+            }
+            return GolombCodedSet(basicParams(blockHash), elements);
+        }
+
+        GolombCodedSet BlockFilter::parse(const Digest256& blockHash, std::vector<uint8_t> encoded) {
+            return GolombCodedSet(basicParams(blockHash), std::move(encoded));
+        }
+
+        Digest256 BlockFilter::header(const std::vector<uint8_t>& encoded, const Digest256& previousHeader) {
+            uint8_t preimage[64];
+            Digest256 filterHash = Hash::sha256dRaw(encoded.data(), encoded.size());
+            std::memcpy(preimage, filterHash.data(), 32);
+            std::memcpy(preimage + 32, previousHeader.data(), 32);
+            return Hash::sha256dRaw(preimage, sizeof(preimage));
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
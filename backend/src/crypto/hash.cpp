@@ -1,15 +1,94 @@
 #include "crypto/hash.h"
-#include <openssl/sha.h>
-#include <openssl/ripemd.h>
-#include <iomanip>
-#include <sstream>
 #include <algorithm>
 #include <stdexcept>
+#include <unordered_map>
+#include "crypto/gcs.h"
+#include "crypto/hash160.h"
+#include "crypto/hash_backend.h"
+#include "crypto/hasher.h"
+#include "crypto/hex.h"
+#include "crypto/hmac.h"
+#include "crypto/kdf.h"
+#include "crypto/merkle.h"
+#include "crypto/sha256_transform.h"
+#include "crypto/tagged_hash.h"
 #include "utils/Logger.h"
+#include "utils/MappedFile.h"
+#include "utils/Metrics.h"
+#include "utils/Trace.h"
 
 namespace Crypto {
     namespace SHA256 {
 
+        namespace {
+            using Crypto::Utils::Counter;
+            using Crypto::Utils::Histogram;
+            using Crypto::Utils::Metrics;
+            using Crypto::Utils::ScopedTimer;
+
+            // Hot-path metric handles, registered on first use
+            struct HashMetrics {
+                Counter& sha256Calls = calls("sha256");
+                Counter& sha256Bytes = bytes("sha256");
+                Counter& sha256dCalls = calls("sha256d");
+                Counter& sha256dBytes = bytes("sha256d");
+                Counter& ripemd160Calls = calls("ripemd160");
+                Counter& ripemd160Bytes = bytes("ripemd160");
+                Counter& hash160Calls = calls("hash160");
+                Counter& hash160Bytes = bytes("hash160");
+                Counter& fileBytes = Metrics::counter("crypto_file_hash_bytes_total", "Bytes streamed through file hashing");
+                Histogram& fileDuration = Metrics::histogram("crypto_file_hash_duration_seconds", "File hashing latency");
+                Counter& merkleLeaves = Metrics::counter("crypto_merkle_leaves_total", "Leaves folded into Merkle roots");
+                Histogram& merkleDuration = Metrics::histogram("crypto_merkle_root_duration_seconds", "Merkle root latency");
+
+                static Counter& calls(const char* algorithm) {
+                    return Metrics::counter("crypto_hash_operations_total", "Digests computed",
+                                            std::string("algorithm=\"") + algorithm + "\"");
+                }
+                static Counter& bytes(const char* algorithm) {
+                    return Metrics::counter("crypto_hash_bytes_total", "Bytes hashed",
+                                            std::string("algorithm=\"") + algorithm + "\"");
+                }
+            };
+
+            HashMetrics& metrics() {
+                static HashMetrics instance;
+                return instance;
+            }
+
+            void countBatch(Counter& calls, Counter& bytes, const ByteView* inputs, size_t count) {
+                size_t total = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    total += inputs[i].size();
+                }
+                calls.add(count);
+                bytes.add(total);
+            }
+
+            // Single-shot digests through the selected backend; the public entry points count, these do not
+            void backendSha256(const uint8_t* data, size_t length, uint8_t* out) {
+                HashBackendRegistry::active().sha256(data, length, out);
+            }
+
+            void backendRipemd160(const uint8_t* data, size_t length, uint8_t* out) {
+                HashBackendRegistry::activeRipemd160().ripemd160(data, length, out);
+            }
+
+            template <typename Hasher>
+            typename Hasher::DigestType digestFile(const std::string& filePath) {
+                HashMetrics& counters = metrics();
+                ScopedTimer timer(counters.fileDuration);
+                CRYPTO_TRACE_SCOPE("hashFile");
+                Hasher hasher;
+                Crypto::Utils::MappedFile::forEachChunk(filePath, Crypto::Utils::MappedFile::DEFAULT_CHUNK_SIZE,
+                    [&hasher, &counters](const uint8_t* chunk, size_t length) {
+                        hasher.update(chunk, length);
+                        counters.fileBytes.add(length);
+                    });
+                return hasher.finalize();
+            }
+        }
+
         // Constructor
         Hash::Hash() {
             Crypto::Utils::Logger::getInstance()->log(Crypto::Utils::LogLevel::INFO, "Hash initialized.");
@@ -23,9 +102,8 @@ namespace Crypto {
         // SHA-256 single hash (string input)
         std::string Hash::sha256(const std::string& data) {
             try {
-                std::vector<uint8_t> bytes(data.begin(), data.end());
-                std::string result = bytesToHex(sha256Raw(bytes));
-                Crypto::Utils::Logger::getInstance()->debug("SHA-256 hash computed for " + std::to_string(data.length()) + " bytes");
+                std::string result = sha256Raw(ByteView(data)).toHex();
+                SLOG_DEBUG("SHA-256 hash computed for {} bytes", data.length());
                 return result;
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("SHA-256 hash failed: " + std::string(e.what()));
@@ -36,8 +114,8 @@ namespace Crypto {
         // SHA-256 single hash (bytes input)  
         std::string Hash::sha256(const std::vector<uint8_t>& data) {
             try {
-                std::string result = bytesToHex(sha256Raw(data));
-                Crypto::Utils::Logger::getInstance()->debug("SHA-256 hash computed for " + std::to_string(data.size()) + " bytes");
+                std::string result = sha256Raw(ByteView(data)).toHex();
+                SLOG_DEBUG("SHA-256 hash computed for {} bytes", data.size());
                 return result;
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("SHA-256 hash failed: " + std::string(e.what()));
@@ -48,9 +126,8 @@ namespace Crypto {
         // SHA-256 double hash (Bitcoin standard)
         std::string Hash::sha256d(const std::string& data) {
             try {
-                std::vector<uint8_t> bytes(data.begin(), data.end());
-                std::string result = sha256d(bytes);
-                Crypto::Utils::Logger::getInstance()->debug("SHA-256d hash computed for string data");
+                std::string result = sha256dRaw(ByteView(data)).toHex();
+                SLOG_DEBUG("SHA-256d hash computed for string data");
                 return result;
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("SHA-256d hash failed: " + std::string(e.what()));
@@ -60,10 +137,8 @@ namespace Crypto {
 
         std::string Hash::sha256d(const std::vector<uint8_t>& data) {
             try {
-                auto firstHash = sha256Raw(data);
-                auto secondHash = sha256Raw(firstHash);
-                std::string result = bytesToHex(secondHash);
-                Crypto::Utils::Logger::getInstance()->debug("SHA-256d double hash computed");
+                std::string result = sha256dRaw(ByteView(data)).toHex();
+                SLOG_DEBUG("SHA-256d double hash computed");
                 return result;
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("SHA-256d double hash failed: " + std::string(e.what()));
@@ -74,9 +149,8 @@ namespace Crypto {
         // RIPEMD-160 hash (string input)
         std::string Hash::ripemd160(const std::string& data) {
             try {
-                std::vector<uint8_t> bytes(data.begin(), data.end());
-                std::string result = bytesToHex(ripemd160Raw(bytes));
-                Crypto::Utils::Logger::getInstance()->debug("RIPEMD-160 hash computed for string data");
+                std::string result = ripemd160Raw(ByteView(data)).toHex();
+                SLOG_DEBUG("RIPEMD-160 hash computed for string data");
                 return result;
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("RIPEMD-160 hash failed: " + std::string(e.what()));
@@ -87,8 +161,8 @@ namespace Crypto {
         // RIPEMD-160 hash (bytes input)
         std::string Hash::ripemd160(const std::vector<uint8_t>& data) {
             try {
-                std::string result = bytesToHex(ripemd160Raw(data));
-                Crypto::Utils::Logger::getInstance()->debug("RIPEMD-160 hash computed for " + std::to_string(data.size()) + " bytes");
+                std::string result = ripemd160Raw(ByteView(data)).toHex();
+                SLOG_DEBUG("RIPEMD-160 hash computed for {} bytes", data.size());
                 return result;
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("RIPEMD-160 hash failed: " + std::string(e.what()));
@@ -99,11 +173,19 @@ namespace Crypto {
         // Hash160: SHA-256 then RIPEMD-160 (for Bitcoin addresses)
         std::string Hash::hash160(const std::string& data) {
             try {
-                std::vector<uint8_t> bytes(data.begin(), data.end());
-                auto sha256Hash = sha256Raw(bytes);
-                auto ripemdHash = ripemd160Raw(sha256Hash);
-                std::string result = bytesToHex(ripemdHash);
-                Crypto::Utils::Logger::getInstance()->debug("Hash160 computed for address generation");
+                std::string result = hash160Raw(ByteView(data)).toHex();
+                SLOG_DEBUG("Hash160 computed for address generation");
+                return result;
+            } catch (const std::exception& e) {
+                Crypto::Utils::Logger::getInstance()->error("Hash160 computation failed: " + std::string(e.what()));
+                throw;
+            }
+        }
+
+        std::string Hash::hash160(const std::vector<uint8_t>& data) {
+            try {
+                std::string result = hash160Raw(ByteView(data)).toHex();
+                SLOG_DEBUG("Hash160 computed for address generation");
                 return result;
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("Hash160 computation failed: " + std::string(e.what()));
@@ -111,66 +193,34 @@ namespace Crypto {
             }
         }
 
-        // Merkle tree root calculation
+        // Merkle tree root calculation (legacy hex-concatenation layout)
         std::string Hash::merkleRoot(const std::vector<std::string>& hashes) {
             try {
                 if (hashes.empty()) {
                     Crypto::Utils::Logger::getInstance()->warning("Empty hash list provided for Merkle root");
                     return "";
                 }
-                
-                if (hashes.size() == 1) {
-                    Crypto::Utils::Logger::getInstance()->debug("Single hash Merkle root: " + hashes[0]);
-                    return hashes[0];
-                }
-                
-                std::vector<std::string> nextLevel;
-                
-                // Process pairs of hashes
-                for (size_t i = 0; i < hashes.size(); i += 2) {
-                    std::string left = hashes[i];
-                    std::string right;
-                    
-                    // If odd number of hashes, duplicate the last one
-                    if (i + 1 < hashes.size()) {
-                        right = hashes[i + 1];
-                    } else {
-                        right = left;
-                        Crypto::Utils::Logger::getInstance()->debug("Duplicating last hash for Merkle tree");
-                    }
-                    
-                    // Combine left and right hashes and hash them
-                    std::string combined = left + right;
-                    std::string hashedPair = sha256d(combined);
-                    nextLevel.push_back(hashedPair);
-                }
-                
-                Crypto::Utils::Logger::getInstance()->debug("Merkle tree level processed: " + 
-                    std::to_string(hashes.size()) + " -> " + std::to_string(nextLevel.size()));
-                
-                // Recursive call until we get single root
-                return merkleRoot(nextLevel);
+                metrics().merkleLeaves.add(hashes.size());
+                ScopedTimer timer(metrics().merkleDuration);
+                CRYPTO_TRACE_SCOPE("merkleRoot", "leaves", static_cast<int64_t>(hashes.size()));
+                return MerkleEngine::shared().root(hashes, MerkleMode::LEGACY_HEX);
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("Merkle root calculation failed: " + std::string(e.what()));
                 throw;
             }
         }
 
+        // Merkle tree root calculation over raw digests (binary pair layout)
+        Digest256 Hash::merkleRoot(const std::vector<Digest256>& leaves) {
+            metrics().merkleLeaves.add(leaves.size());
+            ScopedTimer timer(metrics().merkleDuration);
+            CRYPTO_TRACE_SCOPE("merkleRoot", "leaves", static_cast<int64_t>(leaves.size()));
+            return MerkleEngine::shared().root(leaves);
+        }
+
         // Convert bytes to hex string
         std::string Hash::bytesToHex(const std::vector<uint8_t>& bytes) {
-            try {
-                std::stringstream ss;
-                ss << std::hex << std::setfill('0');
-                
-                for (const auto& byte : bytes) {
-                    ss << std::setw(2) << static_cast<int>(byte);
-                }
-                
-                return ss.str();
-            } catch (const std::exception& e) {
-                Crypto::Utils::Logger::getInstance()->error("Bytes to hex conversion failed: " + std::string(e.what()));
-                throw;
-            }
+            return Hex::encode(bytes.data(), bytes.size());
         }
 
         // Convert hex string to bytes
@@ -179,17 +229,12 @@ namespace Crypto {
                 if (hex.length() % 2 != 0) {
                     throw std::invalid_argument("Hex string must have even length");
                 }
-                
-                std::vector<uint8_t> bytes;
-                bytes.reserve(hex.length() / 2);
-                
-                for (size_t i = 0; i < hex.length(); i += 2) {
-                    std::string byteString = hex.substr(i, 2);
-                    auto byte = static_cast<uint8_t>(std::stoul(byteString, nullptr, 16));
-                    bytes.push_back(byte);
+
+                std::vector<uint8_t> bytes(hex.length() / 2);
+                HexDecodeResult result = Hex::decode(hex.data(), hex.length(), bytes.data());
+                if (!result) {
+                    throw std::invalid_argument("Invalid hex character at offset " + std::to_string(result.errorOffset));
                 }
-                
-                Crypto::Utils::Logger::getInstance()->debug("Converted hex string to " + std::to_string(bytes.size()) + " bytes");
                 return bytes;
             } catch (const std::exception& e) {
                 Crypto::Utils::Logger::getInstance()->error("Hex to bytes conversion failed: " + std::string(e.what()));
@@ -197,50 +242,214 @@ namespace Crypto {
             }
         }
 
-        // Private: Raw SHA-256 implementation using OpenSSL
-        std::vector<uint8_t> Hash::sha256Raw(const std::vector<uint8_t>& data) {
-            std::vector<uint8_t> hash(SHA256_DIGEST_LENGTH);
-            
-            SHA256_CTX sha256Context;
-            if (SHA256_Init(&sha256Context) != 1) {
-                Crypto::Utils::Logger::getInstance()->critical("Failed to initialize SHA256 context");
-                throw std::runtime_error("Failed to initialize SHA256 context");
+        // Raw SHA-256 through the selected backend
+        Digest256 Hash::sha256Raw(const uint8_t* data, size_t length) {
+            HashMetrics& counters = metrics();
+            counters.sha256Calls.increment();
+            counters.sha256Bytes.add(length);
+            Digest256 hash;
+            backendSha256(data, length, hash.data());
+            return hash;
+        }
+
+        Digest256 Hash::sha256Raw(ByteView data) {
+            return sha256Raw(data.data(), data.size());
+        }
+
+        // Raw SHA-256d: the second pass hashes the 32-byte digest in place
+        Digest256 Hash::sha256dRaw(const uint8_t* data, size_t length) {
+            HashMetrics& counters = metrics();
+            counters.sha256dCalls.increment();
+            counters.sha256dBytes.add(length);
+            Digest256 first;
+            backendSha256(data, length, first.data());
+            Digest256 hash;
+            backendSha256(first.data(), first.size(), hash.data());
+            return hash;
+        }
+
+        Digest256 Hash::sha256dRaw(ByteView data) {
+            return sha256dRaw(data.data(), data.size());
+        }
+
+        // Raw RIPEMD-160 through the selected backend
+        Digest160 Hash::ripemd160Raw(const uint8_t* data, size_t length) {
+            HashMetrics& counters = metrics();
+            counters.ripemd160Calls.increment();
+            counters.ripemd160Bytes.add(length);
+            Digest160 hash;
+            backendRipemd160(data, length, hash.data());
+            return hash;
+        }
+
+        Digest160 Hash::ripemd160Raw(ByteView data) {
+            return ripemd160Raw(data.data(), data.size());
+        }
+
+        // Raw Hash160: RIPEMD-160 over the SHA-256 digest
+        Digest160 Hash::hash160Raw(const uint8_t* data, size_t length) {
+            HashMetrics& counters = metrics();
+            counters.hash160Calls.increment();
+            counters.hash160Bytes.add(length);
+            Digest256 sha;
+            backendSha256(data, length, sha.data());
+            Digest160 hash;
+            backendRipemd160(sha.data(), sha.size(), hash.data());
+            return hash;
+        }
+
+        Digest160 Hash::hash160Raw(ByteView data) {
+            return hash160Raw(data.data(), data.size());
+        }
+
+        // Batch SHA-256 over independent inputs (AVX2 8-way / SSE4.1 4-way / SHA-NI / scalar)
+        void Hash::sha256Batch(const ByteView* inputs, Digest256* outputs, size_t count) {
+            countBatch(metrics().sha256Calls, metrics().sha256Bytes, inputs, count);
+            CRYPTO_TRACE_SCOPE("sha256Batch", "count", static_cast<int64_t>(count));
+            Transform::hashBatch(inputs, outputs, count, false);
+        }
+
+        void Hash::sha256dBatch(const ByteView* inputs, Digest256* outputs, size_t count) {
+            countBatch(metrics().sha256dCalls, metrics().sha256dBytes, inputs, count);
+            CRYPTO_TRACE_SCOPE("sha256dBatch", "count", static_cast<int64_t>(count));
+            Transform::hashBatch(inputs, outputs, count, true);
+        }
+
+        std::vector<Digest256> Hash::sha256Batch(const std::vector<ByteView>& inputs) {
+            std::vector<Digest256> outputs(inputs.size());
+            sha256Batch(inputs.data(), outputs.data(), inputs.size());
+            return outputs;
+        }
+
+        std::vector<Digest256> Hash::sha256dBatch(const std::vector<ByteView>& inputs) {
+            std::vector<Digest256> outputs(inputs.size());
+            sha256dBatch(inputs.data(), outputs.data(), inputs.size());
+            return outputs;
+        }
+
+        // Batch Hash160 for address derivation; contiguous records avoid building views on the caller side
+        void Hash::hash160Batch(const ByteView* inputs, Digest160* outputs, size_t count) {
+            countBatch(metrics().hash160Calls, metrics().hash160Bytes, inputs, count);
+            CRYPTO_TRACE_SCOPE("hash160Batch", "count", static_cast<int64_t>(count));
+            Hash160Engine::shared().hash(inputs, outputs, count);
+        }
+
+        void Hash::hash160Batch(const uint8_t* inputs, size_t inputSize, size_t count, Digest160* outputs) {
+            metrics().hash160Calls.add(count);
+            metrics().hash160Bytes.add(inputSize * count);
+            CRYPTO_TRACE_SCOPE("hash160Batch", "count", static_cast<int64_t>(count));
+            Hash160Engine::shared().hash(inputs, inputSize, count, outputs);
+        }
+
+        std::vector<Digest160> Hash::hash160Batch(const std::vector<ByteView>& inputs) {
+            std::vector<Digest160> outputs(inputs.size());
+            hash160Batch(inputs.data(), outputs.data(), inputs.size());
+            return outputs;
+        }
+
+        // Tagged hashes resume from the tag's prefix midstate: one compression for messages up to 55 bytes
+        Digest256 Hash::taggedHash(const TaggedHash& tag, ByteView message) {
+            return tag(message);
+        }
+
+        Digest256 Hash::taggedHash(const std::string& tag, ByteView message) {
+            thread_local std::unordered_map<std::string, TaggedHash> prefixes;
+            auto it = prefixes.find(tag);
+            if (it == prefixes.end()) {
+                it = prefixes.emplace(tag, TaggedHash(tag.data(), tag.size())).first;
             }
-            
-            if (SHA256_Update(&sha256Context, data.data(), data.size()) != 1) {
-                Crypto::Utils::Logger::getInstance()->critical("Failed to update SHA256 hash");
-                throw std::runtime_error("Failed to update SHA256 hash");
+            return it->second(message);
+        }
+
+        // HMAC and key derivation
+        Digest256 Hash::hmacSha256(ByteView key, ByteView message) {
+            return HmacSha256(key).update(message).finalize();
+        }
+
+        Digest512 Hash::hmacSha512(ByteView key, ByteView message) {
+            return HmacSha512(key).update(message).finalize();
+        }
+
+        std::vector<uint8_t> Hash::pbkdf2Sha256(ByteView password, ByteView salt, uint32_t iterations, size_t length) {
+            try {
+                std::vector<uint8_t> key(length);
+                Kdf::pbkdf2Sha256(password, salt, iterations, key.data(), length);
+                return key;
+            } catch (const std::exception& e) {
+                Crypto::Utils::Logger::getInstance()->error("PBKDF2-HMAC-SHA256 derivation failed: " + std::string(e.what()));
+                throw;
             }
-            
-            if (SHA256_Final(hash.data(), &sha256Context) != 1) {
-                Crypto::Utils::Logger::getInstance()->critical("Failed to finalize SHA256 hash");
-                throw std::runtime_error("Failed to finalize SHA256 hash");
+        }
+
+        std::vector<uint8_t> Hash::pbkdf2Sha512(ByteView password, ByteView salt, uint32_t iterations, size_t length) {
+            try {
+                std::vector<uint8_t> key(length);
+                Kdf::pbkdf2Sha512(password, salt, iterations, key.data(), length);
+                return key;
+            } catch (const std::exception& e) {
+                Crypto::Utils::Logger::getInstance()->error("PBKDF2-HMAC-SHA512 derivation failed: " + std::string(e.what()));
+                throw;
             }
-            
-            return hash;
         }
 
-        // Private: Raw RIPEMD-160 implementation using OpenSSL
-        std::vector<uint8_t> Hash::ripemd160Raw(const std::vector<uint8_t>& data) {
-            std::vector<uint8_t> hash(RIPEMD160_DIGEST_LENGTH);
-            
-            RIPEMD160_CTX ripemdContext;
-            if (RIPEMD160_Init(&ripemdContext) != 1) {
-                Crypto::Utils::Logger::getInstance()->critical("Failed to initialize RIPEMD160 context");
-                throw std::runtime_error("Failed to initialize RIPEMD160 context");
+        std::vector<uint8_t> Hash::hkdfSha256(ByteView inputKey, ByteView salt, ByteView info, size_t length) {
+            try {
+                std::vector<uint8_t> key(length);
+                Kdf::hkdfSha256(inputKey, salt, info, key.data(), length);
+                return key;
+            } catch (const std::exception& e) {
+                Crypto::Utils::Logger::getInstance()->error("HKDF-SHA256 derivation failed: " + std::string(e.what()));
+                throw;
             }
-            
-            if (RIPEMD160_Update(&ripemdContext, data.data(), data.size()) != 1) {
-                Crypto::Utils::Logger::getInstance()->critical("Failed to update RIPEMD160 hash");
-                throw std::runtime_error("Failed to update RIPEMD160 hash");
+        }
+
+        // Block filters: build and match wrap GolombCodedSet with the BIP158 basic parameters
+        std::vector<uint8_t> Hash::blockFilter(const Digest256& blockHash, const std::vector<ByteView>& scripts) {
+            return BlockFilter::build(blockHash, scripts).encoded();
+        }
+
+        bool Hash::blockFilterMatchAny(const Digest256& blockHash, const std::vector<uint8_t>& filter,
+                                       const std::vector<ByteView>& scripts) {
+            try {
+                return BlockFilter::parse(blockHash, filter).matchAny(scripts);
+            } catch (const std::exception& e) {
+                Crypto::Utils::Logger::getInstance()->error("Block filter match failed: " + std::string(e.what()));
+                throw;
             }
-            
-            if (RIPEMD160_Final(hash.data(), &ripemdContext) != 1) {
-                Crypto::Utils::Logger::getInstance()->critical("Failed to finalize RIPEMD160 hash");
-                throw std::runtime_error("Failed to finalize RIPEMD160 hash");
+        }
+
+        Digest256 Hash::blockFilterHeader(const std::vector<uint8_t>& filter, const Digest256& previousHeader) {
+            return BlockFilter::header(filter, previousHeader);
+        }
+
+        // File hashing: the file is streamed through fixed mapped windows into an incremental hasher
+        Digest256 Hash::sha256File(const std::string& filePath) {
+            return digestFile<Sha256Hasher>(filePath);
+        }
+
+        Digest256 Hash::sha256dFile(const std::string& filePath) {
+            return digestFile<Sha256dHasher>(filePath);
+        }
+
+        Digest160 Hash::ripemd160File(const std::string& filePath) {
+            return digestFile<Ripemd160Hasher>(filePath);
+        }
+
+        std::string Hash::hashFile(const std::string& filePath, HashAlgorithm algorithm) {
+            try {
+                std::string result;
+                switch (algorithm) {
+                    case HashAlgorithm::SHA256: result = sha256File(filePath).toHex(); break;
+                    case HashAlgorithm::SHA256D: result = sha256dFile(filePath).toHex(); break;
+                    case HashAlgorithm::RIPEMD160: result = ripemd160File(filePath).toHex(); break;
+                    default: throw std::invalid_argument("Unknown hash algorithm");
+                }
+                SLOG_DEBUG("File hash computed for {}", filePath);
+                return result;
+            } catch (const std::exception& e) {
+                Crypto::Utils::Logger::getInstance()->error("File hash failed: " + std::string(e.what()));
+                throw;
             }
-            
-            return hash;
         }
 
     } // namespace SHA256
@@ -0,0 +1,83 @@
+#include "crypto/hash160.h"
+#include "crypto/ripemd160_transform.h"
+#include "crypto/sha256_transform.h"
+#include "utils/Config.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        static_assert(sizeof(Digest256) == 32, "Digest256 arrays must be contiguous 32-byte records");
+        static_assert(sizeof(Digest160) == 20, "Digest160 arrays must be contiguous 20-byte records");
+
+        namespace {
+            // SHA-256 of one chunk, then RIPEMD-160 of the digests straight into the outputs
+            void hashChunk(const ByteView* inputs, Digest160* outputs, size_t count) {
+                Digest256 digests[Hash160Engine::CHUNK_SIZE];
+                Transform::hashBatch(inputs, digests, count, false);
+                Ripemd160Transform::hash32(outputs[0].data(), digests[0].data(), count);
+            }
+        }
+
+        Hash160Engine::Hash160Engine(size_t threadCount) {
+            if (threadCount == 0) {
+                threadCount = Utils::ThreadPool::configuredThreadCount();
+            }
+            // The calling thread also takes a share of every parallel batch (the pool may be empty)
+            pool = std::make_unique<Utils::ThreadPool>(threadCount - 1);
+        }
+
+        Hash160Engine::~Hash160Engine() = default;
+
+        size_t Hash160Engine::threadCount() const {
+            return pool ? pool->size() + 1 : 1;
+        }
+
+        const Hash160Engine& Hash160Engine::shared() {
+            static Hash160Engine engine;
+            // Follow `mining.threadCount` across config reloads
+            static const size_t subscription = Utils::Config::subscribe(
+                [](const Utils::ConfigSnapshot& previous, const Utils::ConfigSnapshot& next) {
+                    if (previous.mining.threadCount != next.mining.threadCount) {
+                        engine.pool->resize(Utils::ThreadPool::configuredThreadCount() - 1);
+                    }
+                });
+            (void)subscription;
+            return engine;
+        }
+
+        // Hand [begin, end) ranges of at most CHUNK_SIZE items to `body`, in parallel for large batches
+        template <typename Body>
+        void Hash160Engine::run(size_t count, const Body& body) const {
+            auto chunked = [&body](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i += CHUNK_SIZE) {
+                    body(i, std::min(end, i + CHUNK_SIZE));
+                }
+            };
+            if (pool && count >= PARALLEL_THRESHOLD) {
+                pool->parallelFor(count, PARALLEL_THRESHOLD / 2, chunked);
+            } else {
+                chunked(0, count);
+            }
+        }
+
+        void Hash160Engine::hash(const ByteView* inputs, Digest160* outputs, size_t count) const {
+            run(count, [inputs, outputs](size_t begin, size_t end) {
+                hashChunk(inputs + begin, outputs + begin, end - begin);
+            });
+        }
+
+        void Hash160Engine::hash(const uint8_t* inputs, size_t inputSize, size_t count, Digest160* outputs) const {
+            run(count, [inputs, inputSize, outputs](size_t begin, size_t end) {
+                ByteView views[CHUNK_SIZE];
+                for (size_t i = begin; i < end; ++i) {
+                    views[i - begin] = ByteView(inputs + i * inputSize, inputSize);
+                }
+                hashChunk(views, outputs + begin, end - begin);
+            });
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
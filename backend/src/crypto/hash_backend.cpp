@@ -0,0 +1,290 @@
+#include "crypto/hash_backend.h"
+#include "crypto/hasher.h"
+#include "crypto/sha256_transform.h"
+#include "utils/Config.h"
+#include "utils/Logger.h"
+
+#include <openssl/evp.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            using CompressFunction = void (*)(uint32_t*, const uint8_t*, size_t);
+
+            // Whole blocks straight from the input, then the padded tail
+            void sha256OneShot(CompressFunction compress, const uint8_t* data, size_t length, uint8_t out[32]) {
+                uint32_t state[8];
+                std::memcpy(state, Transform::INITIAL_STATE, sizeof(state));
+                size_t blocks = length / 64;
+                if (blocks) {
+                    compress(state, data, blocks);
+                }
+
+                size_t remainder = length % 64;
+                uint8_t tail[128] = {};
+                if (remainder) {
+                    std::memcpy(tail, data + blocks * 64, remainder);
+                }
+                tail[remainder] = 0x80;
+                size_t tailBlocks = remainder + 9 <= 64 ? 1 : 2;
+                uint64_t bits = static_cast<uint64_t>(length) * 8;
+                for (int i = 0; i < 8; ++i) {
+                    tail[tailBlocks * 64 - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+                }
+                compress(state, tail, tailBlocks);
+                Transform::storeDigest(state, out);
+            }
+
+            void ripemd160InTree(const uint8_t* data, size_t length, uint8_t out[20]) {
+                Digest160 digest = Ripemd160Hasher().update(data, length).finalize();
+                std::memcpy(out, digest.data(), 20);
+            }
+
+            class PortableBackend : public HashBackend {
+            public:
+                const char* name() const override { return "portable"; }
+                bool available() const override { return true; }
+                void sha256(const uint8_t* data, size_t length, uint8_t out[32]) const override {
+                    sha256OneShot(Transform::compressScalar, data, length, out);
+                }
+                void ripemd160(const uint8_t* data, size_t length, uint8_t out[20]) const override {
+                    ripemd160InTree(data, length, out);
+                }
+            };
+
+            class NativeBackend : public HashBackend {
+            public:
+                const char* name() const override { return "native"; }
+                bool available() const override {
+                    return Transform::isSupported(Transform::Implementation::SHANI) ||
+                           Transform::isSupported(Transform::Implementation::AVX2);
+                }
+                void sha256(const uint8_t* data, size_t length, uint8_t out[32]) const override {
+                    // AVX2 only widens batches; a single stream without SHA-NI runs the scalar rounds
+                    sha256OneShot(Transform::isSupported(Transform::Implementation::SHANI) ? Transform::compressShaNi
+                                                                                            : Transform::compressScalar,
+                                  data, length, out);
+                }
+                void ripemd160(const uint8_t* data, size_t length, uint8_t out[20]) const override {
+                    ripemd160InTree(data, length, out);
+                }
+            };
+
+            class OpenSslBackend : public HashBackend {
+            public:
+                OpenSslBackend()
+                    : sha256Md(EVP_MD_fetch(nullptr, "SHA256", nullptr)),
+                      ripemd160Md(EVP_MD_fetch(nullptr, "RIPEMD160", nullptr)) {}
+
+                ~OpenSslBackend() override {
+                    EVP_MD_free(sha256Md);
+                    EVP_MD_free(ripemd160Md);
+                }
+
+                const char* name() const override { return "openssl"; }
+                bool available() const override { return sha256Md != nullptr; }
+
+                void sha256(const uint8_t* data, size_t length, uint8_t out[32]) const override {
+                    digest(sha256Md, data, length, out);
+                }
+
+                void ripemd160(const uint8_t* data, size_t length, uint8_t out[20]) const override {
+                    // RIPEMD-160 may live only in the legacy provider; fall back to the in-tree rounds
+                    if (ripemd160Md) {
+                        digest(ripemd160Md, data, length, out);
+                    } else {
+                        ripemd160InTree(data, length, out);
+                    }
+                }
+
+            private:
+                // One context per thread, reinitialized per digest instead of reallocated
+                struct ContextHolder {
+                    EVP_MD_CTX* context = EVP_MD_CTX_new();
+                    ~ContextHolder() { EVP_MD_CTX_free(context); }
+                };
+
+                static void digest(const EVP_MD* md, const uint8_t* data, size_t length, uint8_t* out) {
+                    thread_local ContextHolder holder;
+                    unsigned int written = 0;
+                    if (!holder.context ||
+                        EVP_DigestInit_ex2(holder.context, md, nullptr) != 1 ||
+                        EVP_DigestUpdate(holder.context, data, length) != 1 ||
+                        EVP_DigestFinal_ex(holder.context, out, &written) != 1) {
+                        Crypto::Utils::Logger::getInstance()->critical("OpenSSL EVP digest failed");
+                        throw std::runtime_error("OpenSSL EVP digest failed");
+                    }
+                }
+
+                EVP_MD* sha256Md;
+                EVP_MD* ripemd160Md;
+            };
+
+            struct Registry {
+                PortableBackend portable;
+                NativeBackend native;
+                OpenSslBackend openssl;
+                std::atomic<const HashBackend*> current{nullptr};
+                std::atomic<const HashBackend*> ripemd160Current{nullptr};
+                std::once_flag initialized;
+
+                const HashBackend* find(const std::string& name) const {
+                    for (const HashBackend* backend : {static_cast<const HashBackend*>(&portable),
+                                                       static_cast<const HashBackend*>(&native),
+                                                       static_cast<const HashBackend*>(&openssl)}) {
+                        if (name == backend->name()) return backend;
+                    }
+                    return nullptr;
+                }
+            };
+
+            Registry& registry() {
+                static Registry instance;
+                return instance;
+            }
+
+            double timeBackend(const HashBackend& backend, bool ripemd160) {
+                uint8_t message[1024];
+                uint8_t out[32];
+                for (size_t i = 0; i < sizeof(message); ++i) message[i] = static_cast<uint8_t>(i);
+
+                // Short (64 B) and long (1 KiB) inputs, ~2 ms budget each
+                double total = 0.0;
+                for (size_t length : {size_t(64), sizeof(message)}) {
+                    uint64_t iterations = 0;
+                    auto start = std::chrono::steady_clock::now();
+                    auto elapsed = std::chrono::steady_clock::duration::zero();
+                    do {
+                        for (int i = 0; i < 64; ++i) {
+                            if (ripemd160) {
+                                backend.ripemd160(message, length, out);
+                            } else {
+                                backend.sha256(message, length, out);
+                            }
+                            message[0] ^= out[0];
+                        }
+                        iterations += 64;
+                        elapsed = std::chrono::steady_clock::now() - start;
+                    } while (elapsed < std::chrono::milliseconds(2));
+                    total += std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+                }
+                return total / 2;
+            }
+
+            struct Selection {
+                const HashBackend* sha256;
+                const HashBackend* ripemd160;
+            };
+
+            void apply(const Selection& selection) {
+                // The portable backend is the reference path, so it pins the block kernels to scalar as well
+                Transform::select(std::string(selection.sha256->name()) == "portable" ? Transform::Implementation::SCALAR
+                                                                                     : Transform::detect());
+                registry().ripemd160Current.store(selection.ripemd160, std::memory_order_release);
+                registry().current.store(selection.sha256, std::memory_order_release);
+            }
+
+            Selection fastest() {
+                std::vector<BackendBenchmark> results = HashBackendRegistry::benchmark();
+                const BackendBenchmark* bestSha256 = nullptr;
+                const BackendBenchmark* bestRipemd160 = nullptr;
+                for (const auto& result : results) {
+                    if (!bestSha256 || result.nanosPerHash < bestSha256->nanosPerHash) bestSha256 = &result;
+                    if (!bestRipemd160 || result.ripemd160NanosPerHash < bestRipemd160->ripemd160NanosPerHash) bestRipemd160 = &result;
+                }
+                for (const auto& result : results) {
+                    LOG_DEBUG("Hash backend ", result.name, ": ", result.nanosPerHash, " ns/hash (SHA-256), ",
+                              result.ripemd160NanosPerHash, " ns/hash (RIPEMD-160)");
+                }
+                Registry& reg = registry();
+                return {bestSha256 ? reg.find(bestSha256->name) : &reg.portable,
+                        bestRipemd160 ? reg.find(bestRipemd160->name) : &reg.portable};
+            }
+
+            void configure() {
+                static const Crypto::Utils::ConfigKey backendKey("crypto.hashBackend");
+                std::string requested = backendKey.getString();
+                if (requested.empty()) {
+                    requested = "auto";
+                }
+                if (!HashBackendRegistry::select(requested)) {
+                    Crypto::Utils::Logger::getInstance()->warning("Hash backend '" + requested +
+                        "' unavailable, falling back to auto selection");
+                    HashBackendRegistry::select("auto");
+                }
+            }
+        }
+
+        const HashBackend& HashBackendRegistry::active() {
+            Registry& reg = registry();
+            const HashBackend* backend = reg.current.load(std::memory_order_acquire);
+            if (backend) {
+                return *backend;
+            }
+            std::call_once(reg.initialized, configure);
+            return *reg.current.load(std::memory_order_acquire);
+        }
+
+        const HashBackend& HashBackendRegistry::activeRipemd160() {
+            Registry& reg = registry();
+            const HashBackend* backend = reg.ripemd160Current.load(std::memory_order_acquire);
+            if (backend) {
+                return *backend;
+            }
+            std::call_once(reg.initialized, configure);
+            return *reg.ripemd160Current.load(std::memory_order_acquire);
+        }
+
+        void HashBackendRegistry::initialize() {
+            bool configured = false;
+            std::call_once(registry().initialized, [&configured]() {
+                configure();
+                configured = true;
+            });
+            if (!configured) {
+                configure();
+            }
+        }
+
+        bool HashBackendRegistry::select(const std::string& name) {
+            Selection selection;
+            if (name == "auto") {
+                selection = fastest();
+            } else {
+                const HashBackend* backend = registry().find(name);
+                if (!backend || !backend->available()) {
+                    return false;
+                }
+                selection = {backend, backend};
+            }
+            apply(selection);
+            LOG_INFO("Hash backend selected: ", selection.sha256->name(),
+                     " (block kernel ", Transform::implementationName(Transform::active()),
+                     ", RIPEMD-160 via ", selection.ripemd160->name(), ")");
+            return true;
+        }
+
+        std::vector<const HashBackend*> HashBackendRegistry::backends() {
+            Registry& reg = registry();
+            return {&reg.portable, &reg.native, &reg.openssl};
+        }
+
+        std::vector<BackendBenchmark> HashBackendRegistry::benchmark() {
+            std::vector<BackendBenchmark> results;
+            for (const HashBackend* backend : backends()) {
+                if (backend->available()) {
+                    results.push_back({backend->name(), timeBackend(*backend, false), timeBackend(*backend, true)});
+                }
+            }
+            return results;
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
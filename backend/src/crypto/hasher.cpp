@@ -0,0 +1,246 @@
+#include "crypto/hasher.h"
+#include "crypto/ripemd160_transform.h"
+#include "crypto/sha256_transform.h"
+#include "crypto/sha512_transform.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        // ---------------------------------------------------------------
+        // SHA-256
+        // ---------------------------------------------------------------
+
+        Sha256Hasher::Sha256Hasher() {
+            reset();
+        }
+
+        Sha256Hasher& Sha256Hasher::reset() {
+            std::memcpy(state, Transform::INITIAL_STATE, sizeof(state));
+            totalBytes = 0;
+            return *this;
+        }
+
+        Sha256Hasher& Sha256Hasher::update(const uint8_t* data, size_t length) {
+            size_t buffered = totalBytes % 64;
+            totalBytes += length;
+
+            if (buffered) {
+                size_t take = std::min(length, 64 - buffered);
+                std::memcpy(buffer + buffered, data, take);
+                data += take;
+                length -= take;
+                if (buffered + take < 64) {
+                    return *this;
+                }
+                Transform::compress(state, buffer, 1);
+            }
+
+            // Whole blocks are compressed straight from the caller's memory
+            size_t blocks = length / 64;
+            if (blocks) {
+                Transform::compress(state, data, blocks);
+                data += blocks * 64;
+                length -= blocks * 64;
+            }
+            if (length) {
+                std::memcpy(buffer, data, length);
+            }
+            return *this;
+        }
+
+        Sha256Hasher& Sha256Hasher::update(ByteView data) {
+            return update(data.data(), data.size());
+        }
+
+        Digest256 Sha256Hasher::finalize() {
+            size_t buffered = totalBytes % 64;
+            uint64_t bits = totalBytes * 8;
+
+            uint8_t tail[128] = {};
+            std::memcpy(tail, buffer, buffered);
+            tail[buffered] = 0x80;
+            size_t tailBlocks = buffered + 9 <= 64 ? 1 : 2;
+            for (int i = 0; i < 8; ++i) {
+                tail[tailBlocks * 64 - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+            }
+            Transform::compress(state, tail, tailBlocks);
+
+            Digest256 digest;
+            Transform::storeDigest(state, digest.data());
+            reset();
+            return digest;
+        }
+
+        Sha256Hasher Sha256Hasher::fromMidstate(const uint32_t midstate[8], uint64_t bytesProcessed) {
+            Sha256Hasher hasher;
+            std::memcpy(hasher.state, midstate, sizeof(hasher.state));
+            hasher.totalBytes = bytesProcessed;
+            return hasher;
+        }
+
+        // ---------------------------------------------------------------
+        // SHA-512
+        // ---------------------------------------------------------------
+
+        Sha512Hasher::Sha512Hasher() {
+            reset();
+        }
+
+        Sha512Hasher& Sha512Hasher::reset() {
+            std::memcpy(state, Sha512Transform::INITIAL_STATE, sizeof(state));
+            totalBytes = 0;
+            return *this;
+        }
+
+        Sha512Hasher& Sha512Hasher::update(const uint8_t* data, size_t length) {
+            size_t buffered = totalBytes % 128;
+            totalBytes += length;
+
+            if (buffered) {
+                size_t take = std::min(length, 128 - buffered);
+                std::memcpy(buffer + buffered, data, take);
+                data += take;
+                length -= take;
+                if (buffered + take < 128) {
+                    return *this;
+                }
+                Sha512Transform::compress(state, buffer, 1);
+            }
+
+            size_t blocks = length / 128;
+            if (blocks) {
+                Sha512Transform::compress(state, data, blocks);
+                data += blocks * 128;
+                length -= blocks * 128;
+            }
+            if (length) {
+                std::memcpy(buffer, data, length);
+            }
+            return *this;
+        }
+
+        Sha512Hasher& Sha512Hasher::update(ByteView data) {
+            return update(data.data(), data.size());
+        }
+
+        Digest512 Sha512Hasher::finalize() {
+            size_t buffered = totalBytes % 128;
+            uint64_t bits = totalBytes * 8;
+
+            // The upper 64 bits of the 128-bit length stay zero
+            uint8_t tail[256] = {};
+            std::memcpy(tail, buffer, buffered);
+            tail[buffered] = 0x80;
+            size_t tailBlocks = buffered + 17 <= 128 ? 1 : 2;
+            for (int i = 0; i < 8; ++i) {
+                tail[tailBlocks * 128 - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+            }
+            Sha512Transform::compress(state, tail, tailBlocks);
+
+            Digest512 digest;
+            Sha512Transform::storeDigest(state, digest.data());
+            reset();
+            return digest;
+        }
+
+        Sha512Hasher Sha512Hasher::fromMidstate(const uint64_t midstate[8], uint64_t bytesProcessed) {
+            Sha512Hasher hasher;
+            std::memcpy(hasher.state, midstate, sizeof(hasher.state));
+            hasher.totalBytes = bytesProcessed;
+            return hasher;
+        }
+
+        // ---------------------------------------------------------------
+        // SHA-256d
+        // ---------------------------------------------------------------
+
+        Sha256dHasher& Sha256dHasher::reset() {
+            inner.reset();
+            return *this;
+        }
+
+        Sha256dHasher& Sha256dHasher::update(const uint8_t* data, size_t length) {
+            inner.update(data, length);
+            return *this;
+        }
+
+        Sha256dHasher& Sha256dHasher::update(ByteView data) {
+            inner.update(data);
+            return *this;
+        }
+
+        Digest256 Sha256dHasher::finalize() {
+            Digest256 first = inner.finalize();
+            return inner.update(first).finalize();
+        }
+
+        // ---------------------------------------------------------------
+        // RIPEMD-160
+        // ---------------------------------------------------------------
+
+        Ripemd160Hasher::Ripemd160Hasher() {
+            reset();
+        }
+
+        Ripemd160Hasher& Ripemd160Hasher::reset() {
+            std::memcpy(state, Ripemd160Transform::INITIAL_STATE, sizeof(state));
+            totalBytes = 0;
+            return *this;
+        }
+
+        Ripemd160Hasher& Ripemd160Hasher::update(const uint8_t* data, size_t length) {
+            size_t buffered = totalBytes % 64;
+            totalBytes += length;
+
+            if (buffered) {
+                size_t take = std::min(length, 64 - buffered);
+                std::memcpy(buffer + buffered, data, take);
+                data += take;
+                length -= take;
+                if (buffered + take < 64) {
+                    return *this;
+                }
+                Ripemd160Transform::compress(state, buffer, 1);
+            }
+
+            size_t blocks = length / 64;
+            if (blocks) {
+                Ripemd160Transform::compress(state, data, blocks);
+                data += blocks * 64;
+                length -= blocks * 64;
+            }
+            if (length) {
+                std::memcpy(buffer, data, length);
+            }
+            return *this;
+        }
+
+        Ripemd160Hasher& Ripemd160Hasher::update(ByteView data) {
+            return update(data.data(), data.size());
+        }
+
+        Digest160 Ripemd160Hasher::finalize() {
+            size_t buffered = totalBytes % 64;
+            uint64_t bits = totalBytes * 8;
+
+            // RIPEMD-160 pads like SHA-256 but stores the bit length little-endian
+            uint8_t tail[128] = {};
+            std::memcpy(tail, buffer, buffered);
+            tail[buffered] = 0x80;
+            size_t tailBlocks = buffered + 9 <= 64 ? 1 : 2;
+            for (int i = 0; i < 8; ++i) {
+                tail[tailBlocks * 64 - 8 + i] = static_cast<uint8_t>(bits >> (8 * i));
+            }
+            Ripemd160Transform::compress(state, tail, tailBlocks);
+
+            Digest160 digest;
+            Ripemd160Transform::storeDigest(state, digest.data());
+            reset();
+            return digest;
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
@@ -0,0 +1,234 @@
+#include "crypto/hex.h"
+#include "crypto/cpu_features.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CRYPTO_HEX_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            const char DIGITS[] = "0123456789abcdef";
+
+            // Byte -> two lowercase digits, packed in memory order
+            struct EncodeTable {
+                char pairs[256][2];
+                EncodeTable() {
+                    for (int i = 0; i < 256; ++i) {
+                        pairs[i][0] = DIGITS[i >> 4];
+                        pairs[i][1] = DIGITS[i & 0x0f];
+                    }
+                }
+            };
+
+            // Char -> nibble, 0xff for anything that is not a hex digit
+            struct DecodeTable {
+                uint8_t nibble[256];
+                DecodeTable() {
+                    for (int i = 0; i < 256; ++i) nibble[i] = 0xff;
+                    for (int i = 0; i < 10; ++i) nibble['0' + i] = static_cast<uint8_t>(i);
+                    for (int i = 0; i < 6; ++i) {
+                        nibble['a' + i] = static_cast<uint8_t>(10 + i);
+                        nibble['A' + i] = static_cast<uint8_t>(10 + i);
+                    }
+                }
+            };
+
+            const EncodeTable ENCODE_TABLE;
+            const DecodeTable DECODE_TABLE;
+
+            enum class Kernel { SCALAR, SSSE3, AVX2 };
+
+            Kernel pickKernel() {
+                const CpuFeatures& cpu = CpuFeatures::get();
+                if (cpu.avx2) return Kernel::AVX2;
+                if (cpu.ssse3) return Kernel::SSSE3;
+                return Kernel::SCALAR;
+            }
+
+            Kernel activeKernel() {
+                static const Kernel kernel = pickKernel();
+                return kernel;
+            }
+        }
+
+        // ---------------------------------------------------------------
+        // SCALAR
+        // ---------------------------------------------------------------
+
+        void Hex::encodeScalar(const uint8_t* in, size_t length, char* out) {
+            for (size_t i = 0; i < length; ++i) {
+                out[2 * i] = ENCODE_TABLE.pairs[in[i]][0];
+                out[2 * i + 1] = ENCODE_TABLE.pairs[in[i]][1];
+            }
+        }
+
+        HexDecodeResult Hex::decodeScalar(const char* in, size_t length, uint8_t* out) {
+            size_t pairs = length / 2;
+            for (size_t i = 0; i < pairs; ++i) {
+                uint8_t high = DECODE_TABLE.nibble[static_cast<uint8_t>(in[2 * i])];
+                uint8_t low = DECODE_TABLE.nibble[static_cast<uint8_t>(in[2 * i + 1])];
+                if (high == 0xff || low == 0xff) {
+                    return {false, high == 0xff ? 2 * i : 2 * i + 1};
+                }
+                out[i] = static_cast<uint8_t>((high << 4) | low);
+            }
+            if (length % 2 != 0) {
+                return {false, length};
+            }
+            return {};
+        }
+
+#ifdef CRYPTO_HEX_X86
+
+        // ---------------------------------------------------------------
+        // SSSE3 (16 input bytes / 32 chars per step)
+        // ---------------------------------------------------------------
+
+        __attribute__((target("ssse3")))
+        void Hex::encodeSsse3(const uint8_t* in, size_t length, char* out) {
+            const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(DIGITS));
+            const __m128i mask = _mm_set1_epi8(0x0f);
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16) {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                __m128i high = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+                __m128i low = _mm_shuffle_epi8(lut, _mm_and_si128(bytes, mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+            }
+            encodeScalar(in + i, length - i, out + 2 * i);
+        }
+
+        namespace {
+            // Map 16 chars to nibbles; `valid` gets 0xff in every lane holding a hex digit
+            __attribute__((target("ssse3")))
+            inline __m128i nibbles16(__m128i chars, __m128i& valid) {
+                __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+                __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+                __m128i alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+                __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+                valid = _mm_or_si128(isDigit, isAlpha);
+                return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                                    _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+            }
+        }
+
+        __attribute__((target("ssse3")))
+        HexDecodeResult Hex::decodeSsse3(const char* in, size_t length, uint8_t* out) {
+            // High nibble * 16 + low nibble for each adjacent pair
+            const __m128i weights = _mm_set1_epi16(0x0110);
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32) {
+                __m128i valid0, valid1;
+                __m128i first = nibbles16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), valid0);
+                __m128i second = nibbles16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)), valid1);
+                if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xffff) {
+                    break;    // the scalar tail pinpoints the offending character
+                }
+                __m128i packed = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), packed);
+            }
+            HexDecodeResult tail = decodeScalar(in + i, length - i, out + i / 2);
+            if (!tail) {
+                tail.errorOffset += i;
+            }
+            return tail;
+        }
+
+        // ---------------------------------------------------------------
+        // AVX2 (32 input bytes / 64 chars per step)
+        // ---------------------------------------------------------------
+
+        __attribute__((target("avx2")))
+        void Hex::encodeAvx2(const uint8_t* in, size_t length, char* out) {
+            const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(DIGITS)));
+            const __m256i mask = _mm256_set1_epi8(0x0f);
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32) {
+                __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                __m256i high = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+                __m256i low = _mm256_shuffle_epi8(lut, _mm256_and_si256(bytes, mask));
+                // Unpacks work per 128-bit lane, so the halves are stitched back in order
+                __m256i lo = _mm256_unpacklo_epi8(high, low);
+                __m256i hi = _mm256_unpackhi_epi8(high, low);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(lo, hi, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+            }
+            encodeSsse3(in + i, length - i, out + 2 * i);
+        }
+
+        namespace {
+            __attribute__((target("avx2")))
+            inline __m256i nibbles32(__m256i chars, __m256i& valid) {
+                __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+                __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+                __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+                __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+                valid = _mm256_or_si256(isDigit, isAlpha);
+                return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                                       _mm256_and_si256(isAlpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+            }
+        }
+
+        __attribute__((target("avx2")))
+        HexDecodeResult Hex::decodeAvx2(const char* in, size_t length, uint8_t* out) {
+            const __m256i weights = _mm256_set1_epi16(0x0110);
+            size_t i = 0;
+            for (; i + 64 <= length; i += 64) {
+                __m256i valid0, valid1;
+                __m256i first = nibbles32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), valid0);
+                __m256i second = nibbles32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32)), valid1);
+                if (_mm256_movemask_epi8(_mm256_and_si256(valid0, valid1)) != -1) {
+                    break;
+                }
+                __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+                // packus interleaves 64-bit groups across lanes: restore [first | second] order
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+            }
+            HexDecodeResult tail = decodeSsse3(in + i, length - i, out + i / 2);
+            if (!tail) {
+                tail.errorOffset += i;
+            }
+            return tail;
+        }
+
+#else // !CRYPTO_HEX_X86
+
+        void Hex::encodeSsse3(const uint8_t* in, size_t length, char* out) { encodeScalar(in, length, out); }
+        void Hex::encodeAvx2(const uint8_t* in, size_t length, char* out) { encodeScalar(in, length, out); }
+        HexDecodeResult Hex::decodeSsse3(const char* in, size_t length, uint8_t* out) { return decodeScalar(in, length, out); }
+        HexDecodeResult Hex::decodeAvx2(const char* in, size_t length, uint8_t* out) { return decodeScalar(in, length, out); }
+
+#endif // CRYPTO_HEX_X86
+
+        // ---------------------------------------------------------------
+        // DISPATCH
+        // ---------------------------------------------------------------
+
+        void Hex::encode(const uint8_t* in, size_t length, char* out) {
+            switch (activeKernel()) {
+                case Kernel::AVX2: encodeAvx2(in, length, out); break;
+                case Kernel::SSSE3: encodeSsse3(in, length, out); break;
+                default: encodeScalar(in, length, out); break;
+            }
+        }
+
+        HexDecodeResult Hex::decode(const char* in, size_t length, uint8_t* out) {
+            switch (activeKernel()) {
+                case Kernel::AVX2: return decodeAvx2(in, length, out);
+                case Kernel::SSSE3: return decodeSsse3(in, length, out);
+                default: return decodeScalar(in, length, out);
+            }
+        }
+
+        std::string Hex::encode(const uint8_t* in, size_t length) {
+            std::string out(2 * length, '\0');
+            encode(in, length, &out[0]);
+            return out;
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
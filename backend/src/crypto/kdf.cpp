@@ -0,0 +1,244 @@
+#include "crypto/kdf.h"
+#include "crypto/hmac.h"
+#include "crypto/sha256_transform.h"
+#include "crypto/sha512_transform.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            // Both PBKDF2 compressions hash one pad block plus one digest, so they share
+            // a block layout: the digest, then the 0x80 marker and the message length.
+            struct Sha256Kdf {
+                using Word = uint32_t;
+                using Hasher = Sha256Hasher;
+                static constexpr size_t BLOCK_SIZE = 64;
+                static constexpr size_t DIGEST_SIZE = 32;
+
+                static void compress(Word* state, const uint8_t* block) { Transform::compress(state, block, 1); }
+                static void store(const Word* state, uint8_t* out) { Transform::storeDigest(state, out); }
+                static void pad(uint8_t* block) {
+                    std::memset(block + DIGEST_SIZE, 0, BLOCK_SIZE - DIGEST_SIZE);
+                    block[DIGEST_SIZE] = 0x80;
+                    block[62] = 0x03;    // (64 + 32) * 8 = 768 bits
+                }
+            };
+
+            struct Sha512Kdf {
+                using Word = uint64_t;
+                using Hasher = Sha512Hasher;
+                static constexpr size_t BLOCK_SIZE = 128;
+                static constexpr size_t DIGEST_SIZE = 64;
+
+                static void compress(Word* state, const uint8_t* block) { Sha512Transform::compress(state, block, 1); }
+                static void store(const Word* state, uint8_t* out) { Sha512Transform::storeDigest(state, out); }
+                static void pad(uint8_t* block) {
+                    std::memset(block + DIGEST_SIZE, 0, BLOCK_SIZE - DIGEST_SIZE);
+                    block[DIGEST_SIZE] = 0x80;
+                    block[126] = 0x06;   // (128 + 64) * 8 = 1536 bits
+                }
+            };
+
+            // One PBKDF2 output block T_i of one request
+            template <typename Traits>
+            struct Unit {
+                typename Traits::Word inner[8];
+                typename Traits::Word outer[8];
+                uint8_t block[Traits::BLOCK_SIZE];    // U_j followed by the constant padding
+                uint8_t sum[Traits::DIGEST_SIZE];     // T_i = U_1 ^ ... ^ U_c
+                uint32_t iterations;
+                uint8_t* output;
+                size_t length;
+            };
+
+            inline void xorInto(uint8_t* sum, const uint8_t* value, size_t length) {
+                for (size_t i = 0; i < length; ++i) {
+                    sum[i] ^= value[i];
+                }
+            }
+
+            // Key the HMAC once per request and compute U_1 for each of its output blocks
+            template <typename Traits>
+            void prepareUnits(const Pbkdf2Request& request, std::vector<Unit<Traits>>& units) {
+                if (request.iterations == 0) {
+                    throw std::invalid_argument("PBKDF2 iteration count must be positive");
+                }
+                Hmac<typename Traits::Hasher> hmac(request.password);
+                size_t blocks = (request.outputLength + Traits::DIGEST_SIZE - 1) / Traits::DIGEST_SIZE;
+                for (size_t i = 0; i < blocks; ++i) {
+                    Unit<Traits> unit;
+                    std::memcpy(unit.inner, hmac.innerPad().midstate(), sizeof(unit.inner));
+                    std::memcpy(unit.outer, hmac.outerPad().midstate(), sizeof(unit.outer));
+
+                    uint8_t index[4] = {
+                        static_cast<uint8_t>((i + 1) >> 24), static_cast<uint8_t>((i + 1) >> 16),
+                        static_cast<uint8_t>((i + 1) >> 8), static_cast<uint8_t>(i + 1)
+                    };
+                    Hmac<typename Traits::Hasher> keyed = hmac;
+                    auto first = keyed.update(request.salt).update(index, sizeof(index)).finalize();
+
+                    std::memcpy(unit.block, first.data(), Traits::DIGEST_SIZE);
+                    Traits::pad(unit.block);
+                    std::memcpy(unit.sum, first.data(), Traits::DIGEST_SIZE);
+                    unit.iterations = request.iterations;
+                    unit.output = request.output + i * Traits::DIGEST_SIZE;
+                    unit.length = std::min(Traits::DIGEST_SIZE, request.outputLength - i * Traits::DIGEST_SIZE);
+                    units.push_back(unit);
+                }
+            }
+
+            template <typename Traits>
+            void iterateSingle(Unit<Traits>& unit) {
+                typename Traits::Word state[8];
+                for (uint32_t j = 1; j < unit.iterations; ++j) {
+                    std::memcpy(state, unit.inner, sizeof(state));
+                    Traits::compress(state, unit.block);
+                    Traits::store(state, unit.block);
+                    std::memcpy(state, unit.outer, sizeof(state));
+                    Traits::compress(state, unit.block);
+                    Traits::store(state, unit.block);
+                    xorInto(unit.sum, unit.block, Traits::DIGEST_SIZE);
+                }
+            }
+
+            // LANES units advance together; a unit stops accumulating once its own count is reached
+            template <typename Traits, size_t LANES>
+            void iterateLanes(void (*kernel)(typename Traits::Word*, const uint8_t* const*), Unit<Traits>* units) {
+                using Word = typename Traits::Word;
+                Word inner[8 * LANES];
+                Word outer[8 * LANES];
+                Word state[8 * LANES];
+                Word laneState[8];
+                const uint8_t* blocks[LANES];
+
+                uint32_t maxIterations = 0;
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    for (size_t w = 0; w < 8; ++w) {
+                        inner[w * LANES + lane] = units[lane].inner[w];
+                        outer[w * LANES + lane] = units[lane].outer[w];
+                    }
+                    blocks[lane] = units[lane].block;
+                    maxIterations = std::max(maxIterations, units[lane].iterations);
+                }
+
+                for (uint32_t j = 1; j < maxIterations; ++j) {
+                    std::memcpy(state, inner, sizeof(state));
+                    kernel(state, blocks);
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        for (size_t w = 0; w < 8; ++w) laneState[w] = state[w * LANES + lane];
+                        Traits::store(laneState, units[lane].block);
+                    }
+                    std::memcpy(state, outer, sizeof(state));
+                    kernel(state, blocks);
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        for (size_t w = 0; w < 8; ++w) laneState[w] = state[w * LANES + lane];
+                        Traits::store(laneState, units[lane].block);
+                        if (j < units[lane].iterations) {
+                            xorInto(units[lane].sum, units[lane].block, Traits::DIGEST_SIZE);
+                        }
+                    }
+                }
+            }
+
+            // Full groups of LANES units from `begin`; returns the first unit left over
+            template <typename Traits, size_t LANES>
+            size_t runLanes(void (*kernel)(typename Traits::Word*, const uint8_t* const*),
+                            std::vector<Unit<Traits>>& units, size_t begin) {
+                for (; begin + LANES <= units.size(); begin += LANES) {
+                    iterateLanes<Traits, LANES>(kernel, units.data() + begin);
+                }
+                return begin;
+            }
+
+            template <typename Traits>
+            void pbkdf2(const Pbkdf2Request* requests, size_t count, size_t laneWidth,
+                        size_t (*runWide)(std::vector<Unit<Traits>>&, size_t)) {
+                std::vector<Unit<Traits>> units;
+                size_t total = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    total += (requests[i].outputLength + Traits::DIGEST_SIZE - 1) / Traits::DIGEST_SIZE;
+                }
+                units.reserve(total);
+                for (size_t i = 0; i < count; ++i) {
+                    prepareUnits<Traits>(requests[i], units);
+                }
+                if (laneWidth > 1 && units.size() > 1) {
+                    std::stable_sort(units.begin(), units.end(), [](const Unit<Traits>& a, const Unit<Traits>& b) {
+                        return a.iterations > b.iterations;
+                    });
+                }
+
+                size_t done = laneWidth > 1 ? runWide(units, laneWidth) : 0;
+                for (size_t i = done; i < units.size(); ++i) {
+                    iterateSingle(units[i]);
+                }
+                for (const Unit<Traits>& unit : units) {
+                    std::memcpy(unit.output, unit.sum, unit.length);
+                }
+            }
+
+            size_t runSha256Lanes(std::vector<Unit<Sha256Kdf>>& units, size_t width) {
+                size_t done = 0;
+                if (width == 8) {
+                    done = runLanes<Sha256Kdf, 8>(Transform::compress8Way, units, done);
+                }
+                return runLanes<Sha256Kdf, 4>(Transform::compress4Way, units, done);
+            }
+
+            size_t runSha512Lanes(std::vector<Unit<Sha512Kdf>>& units, size_t) {
+                return runLanes<Sha512Kdf, 4>(Sha512Transform::compress4Way, units, 0);
+            }
+        }
+
+        void Kdf::pbkdf2Sha256(ByteView password, ByteView salt, uint32_t iterations,
+                               uint8_t* output, size_t outputLength) {
+            Pbkdf2Request request{password, salt, iterations, output, outputLength};
+            pbkdf2Sha256Batch(&request, 1);
+        }
+
+        void Kdf::pbkdf2Sha512(ByteView password, ByteView salt, uint32_t iterations,
+                               uint8_t* output, size_t outputLength) {
+            Pbkdf2Request request{password, salt, iterations, output, outputLength};
+            pbkdf2Sha512Batch(&request, 1);
+        }
+
+        void Kdf::pbkdf2Sha256Batch(const Pbkdf2Request* requests, size_t count) {
+            pbkdf2<Sha256Kdf>(requests, count, Transform::laneWidth(), runSha256Lanes);
+        }
+
+        void Kdf::pbkdf2Sha512Batch(const Pbkdf2Request* requests, size_t count) {
+            pbkdf2<Sha512Kdf>(requests, count, Sha512Transform::laneWidth(), runSha512Lanes);
+        }
+
+        Digest256 Kdf::hkdfExtract(ByteView salt, ByteView inputKey) {
+            // An absent salt is HashLen zero bytes, which HMAC pads to the same key as an empty one
+            return HmacSha256(salt).update(inputKey).finalize();
+        }
+
+        void Kdf::hkdfExpand(const Digest256& pseudoRandomKey, ByteView info, uint8_t* output, size_t outputLength) {
+            if (outputLength > 255 * Digest256::SIZE) {
+                throw std::invalid_argument("HKDF output length exceeds 255 * 32 bytes");
+            }
+            HmacSha256 hmac(pseudoRandomKey);
+            Digest256 previous;
+            for (size_t offset = 0, i = 1; offset < outputLength; offset += Digest256::SIZE, ++i) {
+                if (i > 1) {
+                    hmac.update(previous);
+                }
+                uint8_t counter = static_cast<uint8_t>(i);
+                previous = hmac.update(info).update(&counter, 1).finalize();
+                std::memcpy(output + offset, previous.data(), std::min(Digest256::SIZE, outputLength - offset));
+            }
+        }
+
+        void Kdf::hkdfSha256(ByteView inputKey, ByteView salt, ByteView info, uint8_t* output, size_t outputLength) {
+            hkdfExpand(hkdfExtract(salt, inputKey), info, output, outputLength);
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
@@ -0,0 +1,171 @@
+#include "crypto/merkle.h"
+#include "crypto/hash.h"
+#include "crypto/hasher.h"
+#include "crypto/hex.h"
+#include "crypto/sha256_transform.h"
+#include "utils/Config.h"
+#include "utils/ThreadPool.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        static_assert(sizeof(Digest256) == 32, "Digest256 must be tightly packed so pairs are contiguous");
+
+        namespace {
+            // Per-thread ping-pong buffers; capacity survives across calls
+            thread_local std::vector<Digest256> levelA;
+            thread_local std::vector<Digest256> levelB;
+
+            // Legacy pair: sha256d over hex(left) || hex(right), 128 bytes of text
+            void hashHexPair(const Digest256& left, const Digest256& right, Digest256& out) {
+                char text[128];
+                Hex::encode(left.data(), Digest256::SIZE, text);
+                Hex::encode(right.data(), Digest256::SIZE, text + 64);
+                out = Hash::sha256dRaw(reinterpret_cast<const uint8_t*>(text), sizeof(text));
+            }
+        }
+
+        MerkleEngine::MerkleEngine(size_t threadCount) {
+            if (threadCount == 0) {
+                threadCount = Utils::ThreadPool::configuredThreadCount();
+            }
+            // The calling thread also takes a share of every parallel level (the pool may be empty)
+            pool = std::make_unique<Utils::ThreadPool>(threadCount - 1);
+        }
+
+        MerkleEngine::~MerkleEngine() = default;
+
+        size_t MerkleEngine::threadCount() const {
+            return pool ? pool->size() + 1 : 1;
+        }
+
+        const MerkleEngine& MerkleEngine::shared() {
+            static MerkleEngine engine;
+            // Follow `mining.threadCount` across config reloads
+            static const size_t subscription = Utils::Config::subscribe(
+                [](const Utils::ConfigSnapshot& previous, const Utils::ConfigSnapshot& next) {
+                    if (previous.mining.threadCount != next.mining.threadCount) {
+                        engine.pool->resize(Utils::ThreadPool::configuredThreadCount() - 1);
+                    }
+                });
+            (void)subscription;
+            return engine;
+        }
+
+        // Hash `count` nodes of one level into ceil(count / 2) parents; an odd tail is paired with itself
+        void MerkleEngine::hashLevel(const Digest256* in, Digest256* out, size_t count, MerkleMode mode) const {
+            size_t pairs = count / 2;
+
+            auto body = [in, out, mode](size_t begin, size_t end) {
+                if (mode == MerkleMode::BINARY) {
+                    Transform::sha256d64(out[begin].data(), in[2 * begin].data(), end - begin);
+                } else {
+                    for (size_t i = begin; i < end; ++i) {
+                        hashHexPair(in[2 * i], in[2 * i + 1], out[i]);
+                    }
+                }
+            };
+
+            if (pool && pairs >= PARALLEL_THRESHOLD) {
+                pool->parallelFor(pairs, PARALLEL_THRESHOLD / 2, body);
+            } else {
+                body(0, pairs);
+            }
+
+            if (count % 2 != 0) {
+                const Digest256& last = in[count - 1];
+                if (mode == MerkleMode::BINARY) {
+                    uint8_t duplicated[64];
+                    std::memcpy(duplicated, last.data(), 32);
+                    std::memcpy(duplicated + 32, last.data(), 32);
+                    Transform::sha256d64(out[pairs].data(), duplicated, 1);
+                } else {
+                    hashHexPair(last, last, out[pairs]);
+                }
+            }
+        }
+
+        Digest256 MerkleEngine::root(const Digest256* leaves, size_t count) const {
+            if (count == 0) {
+                return Digest256{};
+            }
+            if (count == 1) {
+                return leaves[0];
+            }
+
+            // The first level reads the caller's leaves directly; later levels ping-pong
+            levelA.resize((count + 1) / 2);
+            hashLevel(leaves, levelA.data(), count, MerkleMode::BINARY);
+            count = (count + 1) / 2;
+
+            std::vector<Digest256>* current = &levelA;
+            std::vector<Digest256>* next = &levelB;
+            while (count > 1) {
+                next->resize((count + 1) / 2);
+                hashLevel(current->data(), next->data(), count, MerkleMode::BINARY);
+                count = (count + 1) / 2;
+                std::swap(current, next);
+            }
+            return (*current)[0];
+        }
+
+        Digest256 MerkleEngine::root(const std::vector<Digest256>& leaves) const {
+            return root(leaves.data(), leaves.size());
+        }
+
+        std::string MerkleEngine::root(const std::vector<std::string>& hashes, MerkleMode mode) const {
+            if (hashes.empty()) {
+                return "";
+            }
+            if (hashes.size() == 1) {
+                return hashes[0];
+            }
+
+            if (mode == MerkleMode::BINARY) {
+                std::vector<Digest256> leaves(hashes.size());
+                for (size_t i = 0; i < hashes.size(); ++i) {
+                    if (!Hex::decode(hashes[i], leaves[i])) {
+                        throw std::invalid_argument("Merkle leaf " + std::to_string(i) + " is not a 32-byte hex digest");
+                    }
+                }
+                return root(leaves).toHex();
+            }
+
+            // Legacy first level hashes the callers' strings as text, whatever their length
+            size_t count = hashes.size();
+            size_t pairs = count / 2;
+            levelA.resize((count + 1) / 2);
+            Digest256* firstLevel = levelA.data();
+            auto leafBody = [&hashes, firstLevel](size_t begin, size_t end) {
+                Sha256dHasher hasher;
+                for (size_t i = begin; i < end; ++i) {
+                    firstLevel[i] = hasher.update(ByteView(hashes[2 * i])).update(ByteView(hashes[2 * i + 1])).finalize();
+                }
+            };
+            if (pool && pairs >= PARALLEL_THRESHOLD) {
+                pool->parallelFor(pairs, PARALLEL_THRESHOLD / 2, leafBody);
+            } else {
+                leafBody(0, pairs);
+            }
+            if (count % 2 != 0) {
+                Sha256dHasher hasher;
+                firstLevel[pairs] = hasher.update(ByteView(hashes.back())).update(ByteView(hashes.back())).finalize();
+            }
+            count = (count + 1) / 2;
+
+            std::vector<Digest256>* current = &levelA;
+            std::vector<Digest256>* next = &levelB;
+            while (count > 1) {
+                next->resize((count + 1) / 2);
+                hashLevel(current->data(), next->data(), count, MerkleMode::LEGACY_HEX);
+                count = (count + 1) / 2;
+                std::swap(current, next);
+            }
+            return (*current)[0].toHex();
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
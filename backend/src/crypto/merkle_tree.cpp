@@ -0,0 +1,214 @@
+#include "crypto/merkle_tree.h"
+#include "crypto/sha256_transform.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            void hashPair(const Digest256& left, const Digest256& right, Digest256& out) {
+                uint8_t pair[64];
+                std::memcpy(pair, left.data(), 32);
+                std::memcpy(pair + 32, right.data(), 32);
+                Transform::sha256d64(out.data(), pair, 1);
+            }
+
+            void checkIndex(size_t index, size_t count) {
+                if (index >= count) {
+                    throw std::out_of_range("Merkle leaf index " + std::to_string(index) +
+                                            " out of range for " + std::to_string(count) + " leaves");
+                }
+            }
+        }
+
+        MerkleTree::MerkleTree(const std::vector<Digest256>& leaves) {
+            build(leaves);
+        }
+
+        size_t MerkleTree::levelCount() const {
+            if (leafCount == 0) {
+                return 0;
+            }
+            size_t levels = 1;
+            for (size_t rest = leafCount - 1; rest != 0; rest >>= 1) {
+                ++levels;
+            }
+            return levels;
+        }
+
+        void MerkleTree::reserveLeaves(size_t count) {
+            if (count <= capacity) {
+                return;
+            }
+            size_t newCapacity = std::max<size_t>(capacity, 1);
+            while (newCapacity < count) {
+                newCapacity *= 2;
+            }
+
+            std::vector<Digest256> relocated(2 * newCapacity - 1);
+            size_t levels = levelCount();
+            for (size_t level = 0; level < levels; ++level) {
+                size_t from = levelOffset(level);
+                size_t to = 2 * newCapacity - ((2 * newCapacity) >> level);
+                std::copy_n(nodes.begin() + from, levelSize(level), relocated.begin() + to);
+            }
+            nodes.swap(relocated);
+            capacity = newCapacity;
+        }
+
+        // Recompute every ancestor of a leaf; these are the only nodes whose subtree range covers it
+        void MerkleTree::rehashPath(size_t index) {
+            size_t levels = levelCount();
+            for (size_t level = 1; level < levels; ++level) {
+                size_t parent = index >> level;
+                size_t left = 2 * parent;
+                if (left + 1 < levelSize(level - 1)) {
+                    Transform::sha256d64(node(level, parent).data(), node(level - 1, left).data(), 1);
+                } else {
+                    hashPair(node(level - 1, left), node(level - 1, left), node(level, parent));
+                }
+            }
+        }
+
+        void MerkleTree::build(const std::vector<Digest256>& leaves) {
+            nodes.clear();
+            capacity = 0;
+            leafCount = 0;
+            if (leaves.empty()) {
+                return;
+            }
+
+            reserveLeaves(leaves.size());
+            std::copy(leaves.begin(), leaves.end(), nodes.begin());
+            leafCount = leaves.size();
+
+            size_t levels = levelCount();
+            for (size_t level = 1; level < levels; ++level) {
+                size_t children = levelSize(level - 1);
+                Transform::sha256d64(node(level, 0).data(), node(level - 1, 0).data(), children / 2);
+                if (children % 2 != 0) {
+                    const Digest256& last = node(level - 1, children - 1);
+                    hashPair(last, last, node(level, children / 2));
+                }
+            }
+        }
+
+        void MerkleTree::append(const Digest256& leaf) {
+            reserveLeaves(leafCount + 1);
+            node(0, leafCount) = leaf;
+            ++leafCount;
+            rehashPath(leafCount - 1);
+        }
+
+        void MerkleTree::replace(size_t index, const Digest256& leaf) {
+            checkIndex(index, leafCount);
+            node(0, index) = leaf;
+            rehashPath(index);
+        }
+
+        void MerkleTree::removeTail() {
+            if (leafCount == 0) {
+                throw std::out_of_range("Cannot remove a leaf from an empty Merkle tree");
+            }
+            --leafCount;
+            if (leafCount > 0) {
+                rehashPath(leafCount - 1);
+            }
+        }
+
+        const Digest256& MerkleTree::leaf(size_t index) const {
+            checkIndex(index, leafCount);
+            return node(0, index);
+        }
+
+        Digest256 MerkleTree::root() const {
+            if (leafCount == 0) {
+                return Digest256{};
+            }
+            return node(levelCount() - 1, 0);
+        }
+
+        MerkleProof MerkleTree::proof(size_t index) const {
+            checkIndex(index, leafCount);
+            MerkleProof result;
+            result.leafIndex = index;
+
+            size_t levels = levelCount();
+            result.siblings.reserve(levels > 0 ? levels - 1 : 0);
+            for (size_t level = 0; level + 1 < levels; ++level) {
+                size_t position = index >> level;
+                size_t sibling = position ^ 1;
+                // A missing right sibling means the node was paired with itself
+                result.siblings.push_back(sibling < levelSize(level) ? node(level, sibling) : node(level, position));
+            }
+            return result;
+        }
+
+        bool MerkleTree::verifyProof(const Digest256& root, const Digest256& leaf, const MerkleProof& proof) {
+            if (proof.siblings.size() < 64 && (proof.leafIndex >> proof.siblings.size()) != 0) {
+                return false;
+            }
+            Digest256 current = leaf;
+            uint64_t position = proof.leafIndex;
+            for (const auto& sibling : proof.siblings) {
+                if (position & 1) {
+                    hashPair(sibling, current, current);
+                } else {
+                    hashPair(current, sibling, current);
+                }
+                position >>= 1;
+            }
+            return current == root;
+        }
+
+        std::vector<bool> MerkleTree::verifyBatch(const Digest256& root, const std::vector<Digest256>& leaves,
+                                                  const std::vector<MerkleProof>& proofs) {
+            if (leaves.size() != proofs.size()) {
+                throw std::invalid_argument("verifyBatch needs one leaf per proof");
+            }
+            size_t count = proofs.size();
+            std::vector<Digest256> current(leaves);
+            std::vector<uint8_t> pairs(64 * count);
+            std::vector<Digest256> hashed(count);
+            std::vector<size_t> active;
+            active.reserve(count);
+
+            size_t depth = 0;
+            for (const auto& proof : proofs) {
+                depth = std::max(depth, proof.siblings.size());
+            }
+
+            for (size_t level = 0; level < depth; ++level) {
+                active.clear();
+                for (size_t k = 0; k < count; ++k) {
+                    if (level >= proofs[k].siblings.size()) {
+                        continue;
+                    }
+                    uint8_t* pair = pairs.data() + 64 * active.size();
+                    const Digest256& sibling = proofs[k].siblings[level];
+                    bool isRight = (proofs[k].leafIndex >> level) & 1;
+                    std::memcpy(pair, (isRight ? sibling : current[k]).data(), 32);
+                    std::memcpy(pair + 32, (isRight ? current[k] : sibling).data(), 32);
+                    active.push_back(k);
+                }
+                Transform::sha256d64(hashed.front().data(), pairs.data(), active.size());
+                for (size_t j = 0; j < active.size(); ++j) {
+                    current[active[j]] = hashed[j];
+                }
+            }
+
+            std::vector<bool> results(count);
+            for (size_t k = 0; k < count; ++k) {
+                size_t levels = proofs[k].siblings.size();
+                bool indexFits = levels >= 64 || (proofs[k].leafIndex >> levels) == 0;
+                results[k] = indexFits && current[k] == root;
+            }
+            return results;
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
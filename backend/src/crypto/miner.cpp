@@ -0,0 +1,311 @@
+#include "crypto/miner.h"
+#include "crypto/sha256_transform.h"
+#include "utils/Logger.h"
+#include "utils/Metrics.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+
+namespace Crypto {
+    namespace SHA256 {
+
+        namespace {
+            // Nonces scanned between polls of the stop/found flags
+            constexpr uint64_t CHECK_INTERVAL = 1 << 14;
+            constexpr size_t NONCE_OFFSET = 12;
+
+            // Per-template constants shared by every thread
+            struct HeaderTemplate {
+                uint32_t midstate[8];
+                uint8_t tail[64];        // header bytes 64..79 plus padding for an 80-byte message
+                Digest256 target;
+                uint32_t targetTop;      // most significant 32 bits of the target
+            };
+
+            struct ScanOutcome {
+                bool found = false;
+                uint32_t nonce = 0;
+                Digest256 hash;
+                uint64_t hashes = 0;
+            };
+
+            inline void writeLE32(uint8_t* p, uint32_t v) {
+                p[0] = static_cast<uint8_t>(v);
+                p[1] = static_cast<uint8_t>(v >> 8);
+                p[2] = static_cast<uint8_t>(v >> 16);
+                p[3] = static_cast<uint8_t>(v >> 24);
+            }
+
+            // Digest bytes 28..31 are the top of the little-endian integer; they sit in state word 7
+            inline uint32_t hashTop(uint32_t stateWord7) {
+                return __builtin_bswap32(stateWord7);
+            }
+
+            inline void padDigestBlock(const uint32_t state[8], uint8_t block[64]) {
+                Transform::storeDigest(state, block);
+                std::memset(block + 32, 0, 32);
+                block[32] = 0x80;
+                block[62] = 0x01;
+            }
+
+            bool checkCandidate(const uint32_t state[8], const HeaderTemplate& tpl, Digest256& hash) {
+                if (hashTop(state[7]) > tpl.targetTop) {
+                    return false;
+                }
+                Transform::storeDigest(state, hash.data());
+                return Miner::meetsTarget(hash, tpl.target);
+            }
+
+            bool scanOne(const HeaderTemplate& tpl, uint32_t nonce, ScanOutcome& outcome) {
+                uint8_t block[64];
+                uint8_t second[64];
+                uint32_t state[8];
+
+                std::memcpy(block, tpl.tail, sizeof(block));
+                writeLE32(block + NONCE_OFFSET, nonce);
+                std::memcpy(state, tpl.midstate, sizeof(state));
+                Transform::compress(state, block, 1);
+                padDigestBlock(state, second);
+                std::memcpy(state, Transform::INITIAL_STATE, sizeof(state));
+                Transform::compress(state, second, 1);
+
+                if (checkCandidate(state, tpl, outcome.hash)) {
+                    outcome.found = true;
+                    outcome.nonce = nonce;
+                    return true;
+                }
+                return false;
+            }
+
+            // LANES consecutive nonces per kernel call: second header block from the
+            // shared midstate, then the second SHA-256 pass, then the target check.
+            template <size_t LANES>
+            bool scanLanes(void (*kernel)(uint32_t*, const uint8_t* const*), const HeaderTemplate& tpl,
+                           uint8_t (&blocks)[LANES][64], uint32_t nonce, ScanOutcome& outcome) {
+                uint32_t state[8 * LANES];
+                uint8_t second[LANES][64];
+                const uint8_t* pointers[LANES];
+                uint32_t laneState[8];
+
+                for (size_t w = 0; w < 8; ++w) {
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        state[w * LANES + lane] = tpl.midstate[w];
+                    }
+                }
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    writeLE32(blocks[lane] + NONCE_OFFSET, nonce + static_cast<uint32_t>(lane));
+                    pointers[lane] = blocks[lane];
+                }
+                kernel(state, pointers);
+
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    for (size_t w = 0; w < 8; ++w) {
+                        laneState[w] = state[w * LANES + lane];
+                        state[w * LANES + lane] = Transform::INITIAL_STATE[w];
+                    }
+                    padDigestBlock(laneState, second[lane]);
+                    pointers[lane] = second[lane];
+                }
+                kernel(state, pointers);
+
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    if (hashTop(state[7 * LANES + lane]) > tpl.targetTop) {
+                        continue;
+                    }
+                    for (size_t w = 0; w < 8; ++w) {
+                        laneState[w] = state[w * LANES + lane];
+                    }
+                    if (checkCandidate(laneState, tpl, outcome.hash)) {
+                        outcome.found = true;
+                        outcome.nonce = nonce + static_cast<uint32_t>(lane);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            template <size_t LANES>
+            uint64_t scanRangeLanes(void (*kernel)(uint32_t*, const uint8_t* const*), const HeaderTemplate& tpl,
+                                    uint64_t begin, uint64_t end, ScanOutcome& outcome) {
+                uint8_t blocks[LANES][64];
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    std::memcpy(blocks[lane], tpl.tail, 64);
+                }
+                uint64_t nonce = begin;
+                for (; nonce + LANES <= end; nonce += LANES) {
+                    if (scanLanes<LANES>(kernel, tpl, blocks, static_cast<uint32_t>(nonce), outcome)) {
+                        return nonce + LANES - begin;
+                    }
+                }
+                for (; nonce < end; ++nonce) {
+                    if (scanOne(tpl, static_cast<uint32_t>(nonce), outcome)) {
+                        return nonce + 1 - begin;
+                    }
+                }
+                return end - begin;
+            }
+
+            // Scan one slice with the widest kernel available; returns the nonces tried
+            uint64_t scanRange(const HeaderTemplate& tpl, uint64_t begin, uint64_t end, ScanOutcome& outcome) {
+                switch (Transform::active()) {
+                    case Transform::Implementation::AVX2:
+                        return scanRangeLanes<8>(Transform::compress8Way, tpl, begin, end, outcome);
+                    case Transform::Implementation::SSE41:
+                        return scanRangeLanes<4>(Transform::compress4Way, tpl, begin, end, outcome);
+                    default:
+                        for (uint64_t nonce = begin; nonce < end; ++nonce) {
+                            if (scanOne(tpl, static_cast<uint32_t>(nonce), outcome)) {
+                                return nonce + 1 - begin;
+                            }
+                        }
+                        return end - begin;
+                }
+            }
+        }
+
+        Miner::Miner(size_t threadCount) {
+            if (threadCount == 0) {
+                threadCount = Utils::ThreadPool::configuredThreadCount();
+            }
+            threads = threadCount;
+            pool = std::make_unique<Utils::ThreadPool>(threads);
+        }
+
+        Miner::~Miner() = default;
+
+        void Miner::stop() {
+            stopRequested.store(true, std::memory_order_relaxed);
+        }
+
+        MiningResult Miner::mine(const BlockHeader& header, const Digest256& target,
+                                 uint32_t startNonce, uint64_t nonceCount) {
+            stopRequested.store(false, std::memory_order_relaxed);
+            nonceCount = std::min<uint64_t>(nonceCount, (uint64_t(1) << 32) - startNonce);
+
+            HeaderTemplate tpl;
+            std::memcpy(tpl.midstate, Transform::INITIAL_STATE, sizeof(tpl.midstate));
+            Transform::compress(tpl.midstate, header.data(), 1);
+            std::memset(tpl.tail, 0, sizeof(tpl.tail));
+            std::memcpy(tpl.tail, header.data() + 64, 16);
+            tpl.tail[16] = 0x80;
+            tpl.tail[62] = 0x02;     // 640-bit message length
+            tpl.tail[63] = 0x80;
+            tpl.target = target;
+            tpl.targetTop = (uint32_t(target[31]) << 24) | (uint32_t(target[30]) << 16) |
+                            (uint32_t(target[29]) << 8) | uint32_t(target[28]);
+
+            MiningResult result;
+            std::atomic<bool> found{false};
+            std::mutex resultMutex;
+            auto started = std::chrono::steady_clock::now();
+
+            uint64_t slice = (nonceCount + threads - 1) / threads;
+            std::vector<std::future<MinerThreadStats>> workers;
+            workers.reserve(threads);
+
+            for (size_t t = 0; t < threads; ++t) {
+                uint64_t begin = uint64_t(startNonce) + std::min<uint64_t>(nonceCount, t * slice);
+                uint64_t end = uint64_t(startNonce) + std::min<uint64_t>(nonceCount, (t + 1) * slice);
+
+                workers.push_back(pool->submit([&, t, begin, end]() {
+                    MinerThreadStats stats;
+                    stats.threadIndex = t;
+                    auto threadStart = std::chrono::steady_clock::now();
+
+                    for (uint64_t chunk = begin; chunk < end; chunk += CHECK_INTERVAL) {
+                        if (found.load(std::memory_order_relaxed) || stopRequested.load(std::memory_order_relaxed)) {
+                            break;
+                        }
+                        ScanOutcome outcome;
+                        stats.hashes += scanRange(tpl, chunk, std::min(end, chunk + CHECK_INTERVAL), outcome);
+                        if (outcome.found) {
+                            std::lock_guard<std::mutex> lock(resultMutex);
+                            if (!result.found) {
+                                result.found = true;
+                                result.nonce = outcome.nonce;
+                                result.hash = outcome.hash;
+                            }
+                            found.store(true, std::memory_order_relaxed);
+                            break;
+                        }
+                    }
+
+                    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - threadStart).count();
+                    stats.hashesPerSecond = stats.seconds > 0 ? stats.hashes / stats.seconds : 0.0;
+                    return stats;
+                }));
+            }
+
+            for (auto& worker : workers) {
+                MinerThreadStats stats = worker.get();
+                result.totalHashes += stats.hashes;
+                result.threads.push_back(stats);
+            }
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            static Crypto::Utils::Counter& minedHashes =
+                Crypto::Utils::Metrics::counter("crypto_mining_hashes_total", "Block header hashes tried by the miner");
+            minedHashes.add(result.totalHashes);
+
+            for (const auto& stats : result.threads) {
+                LOG_DEBUG("Miner thread ", stats.threadIndex, ": ", stats.hashes, " hashes, ",
+                          static_cast<uint64_t>(stats.hashesPerSecond), " H/s");
+            }
+            LOG_INFO(result.found ? "Mining found nonce " + std::to_string(result.nonce) : std::string("Mining exhausted range"),
+                     " after ", result.totalHashes, " hashes using ", Transform::implementationName(Transform::active()));
+            return result;
+        }
+
+        BlockHeader Miner::makeHeader(uint32_t version, const Digest256& previousHash, const Digest256& merkleRoot,
+                                      uint32_t time, uint32_t bits, uint32_t nonce) {
+            BlockHeader header{};
+            writeLE32(header.data(), version);
+            std::memcpy(header.data() + 4, previousHash.data(), 32);
+            std::memcpy(header.data() + 36, merkleRoot.data(), 32);
+            writeLE32(header.data() + 68, time);
+            writeLE32(header.data() + 72, bits);
+            writeLE32(header.data() + 76, nonce);
+            return header;
+        }
+
+        Digest256 Miner::targetFromCompact(uint32_t bits) {
+            uint32_t exponent = bits >> 24;
+            uint32_t mantissa = bits & 0x007fffff;
+            if (bits & 0x00800000) {
+                throw std::invalid_argument("Compact target has the sign bit set");
+            }
+
+            Digest256 target;
+            if (exponent <= 3) {
+                mantissa >>= 8 * (3 - exponent);
+                exponent = 3;
+            }
+            for (uint32_t i = 0; i < 3; ++i) {
+                uint8_t byte = static_cast<uint8_t>(mantissa >> (8 * i));
+                size_t position = exponent - 3 + i;
+                if (position >= Digest256::SIZE) {
+                    if (byte != 0) {
+                        throw std::invalid_argument("Compact target overflows 256 bits");
+                    }
+                    continue;
+                }
+                target[position] = byte;
+            }
+            return target;
+        }
+
+        bool Miner::meetsTarget(const Digest256& hash, const Digest256& target) {
+            for (size_t i = Digest256::SIZE; i-- > 0;) {
+                if (hash[i] != target[i]) {
+                    return hash[i] < target[i];
+                }
+            }
+            return true;
+        }
+
+    } // namespace SHA256
+} // namespace Crypto
@@ -0,0 +1,345 @@
+#include "crypto/ripemd160_transform.h"
+#include "crypto/cpu_features.h"
+#include "crypto/sha256_transform.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CRYPTO_RIPEMD160_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Crypto {
+    namespace SHA256 {
+        namespace Ripemd160Transform {
+
+            const uint32_t INITIAL_STATE[5] = {
+                0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+            };
+
+            namespace {
+                const uint8_t LEFT_WORD[80] = {
+                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                    7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+                    3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+                    1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+                    4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+                };
+                const uint8_t RIGHT_WORD[80] = {
+                    5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+                    6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+                    15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+                    8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+                    12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+                };
+                const uint8_t LEFT_SHIFT[80] = {
+                    11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+                    7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+                    11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+                    11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+                    9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+                };
+                const uint8_t RIGHT_SHIFT[80] = {
+                    8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+                    9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+                    9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+                    15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+                    8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+                };
+                const uint32_t LEFT_K[5] = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+                const uint32_t RIGHT_K[5] = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+
+                inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+                inline uint32_t boolean(int round, uint32_t x, uint32_t y, uint32_t z) {
+                    switch (round) {
+                        case 0: return x ^ y ^ z;
+                        case 1: return (x & y) | (~x & z);
+                        case 2: return (x | ~y) ^ z;
+                        case 3: return (x & z) | (y & ~z);
+                        default: return x ^ (y | ~z);
+                    }
+                }
+
+                inline uint32_t readLE32(const uint8_t* p) {
+                    uint32_t v;
+                    std::memcpy(&v, p, 4);
+                    return v;
+                }
+            }
+
+            void compress(uint32_t state[5], const uint8_t* data, size_t blocks) {
+                while (blocks--) {
+                    uint32_t x[16];
+                    for (int i = 0; i < 16; ++i) {
+                        x[i] = readLE32(data + 4 * i);
+                    }
+
+                    uint32_t al = state[0], bl = state[1], cl = state[2], dl = state[3], el = state[4];
+                    uint32_t ar = al, br = bl, cr = cl, dr = dl, er = el;
+
+                    for (int j = 0; j < 80; ++j) {
+                        int round = j / 16;
+                        uint32_t t = rotl(al + boolean(round, bl, cl, dl) + x[LEFT_WORD[j]] + LEFT_K[round], LEFT_SHIFT[j]) + el;
+                        al = el; el = dl; dl = rotl(cl, 10); cl = bl; bl = t;
+
+                        t = rotl(ar + boolean(4 - round, br, cr, dr) + x[RIGHT_WORD[j]] + RIGHT_K[round], RIGHT_SHIFT[j]) + er;
+                        ar = er; er = dr; dr = rotl(cr, 10); cr = br; br = t;
+                    }
+
+                    uint32_t t = state[1] + cl + dr;
+                    state[1] = state[2] + dl + er;
+                    state[2] = state[3] + el + ar;
+                    state[3] = state[4] + al + br;
+                    state[4] = state[0] + bl + cr;
+                    state[0] = t;
+                    data += 64;
+                }
+            }
+
+#ifdef CRYPTO_RIPEMD160_X86
+
+            // ---------------------------------------------------------------
+            // SSE4.1 (4 lanes of 32-bit words)
+            // ---------------------------------------------------------------
+
+            namespace {
+                __attribute__((target("sse4.1"))) inline __m128i rotl4(__m128i x, int n) {
+                    return _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - n));
+                }
+
+                __attribute__((target("sse4.1"))) inline __m128i load4(const uint8_t* const blocks[4], int offset) {
+                    return _mm_set_epi32(static_cast<int>(readLE32(blocks[3] + offset)), static_cast<int>(readLE32(blocks[2] + offset)),
+                                         static_cast<int>(readLE32(blocks[1] + offset)), static_cast<int>(readLE32(blocks[0] + offset)));
+                }
+
+                __attribute__((target("sse4.1"))) inline __m128i boolean4(int round, __m128i x, __m128i y, __m128i z) {
+                    const __m128i ones = _mm_set1_epi32(-1);
+                    switch (round) {
+                        case 0: return _mm_xor_si128(_mm_xor_si128(x, y), z);
+                        case 1: return _mm_or_si128(_mm_and_si128(x, y), _mm_andnot_si128(x, z));
+                        case 2: return _mm_xor_si128(_mm_or_si128(x, _mm_xor_si128(y, ones)), z);
+                        case 3: return _mm_or_si128(_mm_and_si128(x, z), _mm_andnot_si128(z, y));
+                        default: return _mm_xor_si128(x, _mm_or_si128(y, _mm_xor_si128(z, ones)));
+                    }
+                }
+            }
+
+            __attribute__((target("sse4.1")))
+            void compress4Way(uint32_t state[20], const uint8_t* const blocks[4]) {
+                __m128i s[5];
+                for (int i = 0; i < 5; ++i) {
+                    s[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4 * i));
+                }
+                __m128i x[16];
+                for (int i = 0; i < 16; ++i) {
+                    x[i] = load4(blocks, 4 * i);
+                }
+
+                __m128i al = s[0], bl = s[1], cl = s[2], dl = s[3], el = s[4];
+                __m128i ar = al, br = bl, cr = cl, dr = dl, er = el;
+
+#pragma GCC unroll 80
+                for (int j = 0; j < 80; ++j) {
+                    int round = j / 16;
+                    __m128i t = _mm_add_epi32(al, _mm_add_epi32(boolean4(round, bl, cl, dl),
+                                _mm_add_epi32(x[LEFT_WORD[j]], _mm_set1_epi32(static_cast<int>(LEFT_K[round])))));
+                    t = _mm_add_epi32(rotl4(t, LEFT_SHIFT[j]), el);
+                    al = el; el = dl; dl = rotl4(cl, 10); cl = bl; bl = t;
+
+                    t = _mm_add_epi32(ar, _mm_add_epi32(boolean4(4 - round, br, cr, dr),
+                        _mm_add_epi32(x[RIGHT_WORD[j]], _mm_set1_epi32(static_cast<int>(RIGHT_K[round])))));
+                    t = _mm_add_epi32(rotl4(t, RIGHT_SHIFT[j]), er);
+                    ar = er; er = dr; dr = rotl4(cr, 10); cr = br; br = t;
+                }
+
+                __m128i out[5] = {
+                    _mm_add_epi32(s[1], _mm_add_epi32(cl, dr)),
+                    _mm_add_epi32(s[2], _mm_add_epi32(dl, er)),
+                    _mm_add_epi32(s[3], _mm_add_epi32(el, ar)),
+                    _mm_add_epi32(s[4], _mm_add_epi32(al, br)),
+                    _mm_add_epi32(s[0], _mm_add_epi32(bl, cr))
+                };
+                for (int i = 0; i < 5; ++i) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4 * i), out[i]);
+                }
+            }
+
+            // ---------------------------------------------------------------
+            // AVX2 (8 lanes of 32-bit words)
+            // ---------------------------------------------------------------
+
+            namespace {
+                __attribute__((target("avx2"))) inline __m256i rotl8(__m256i x, int n) {
+                    return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+                }
+
+                __attribute__((target("avx2"))) inline __m256i load8(const uint8_t* const blocks[8], int offset) {
+                    return _mm256_set_epi32(static_cast<int>(readLE32(blocks[7] + offset)), static_cast<int>(readLE32(blocks[6] + offset)),
+                                            static_cast<int>(readLE32(blocks[5] + offset)), static_cast<int>(readLE32(blocks[4] + offset)),
+                                            static_cast<int>(readLE32(blocks[3] + offset)), static_cast<int>(readLE32(blocks[2] + offset)),
+                                            static_cast<int>(readLE32(blocks[1] + offset)), static_cast<int>(readLE32(blocks[0] + offset)));
+                }
+
+                __attribute__((target("avx2"))) inline __m256i boolean8(int round, __m256i x, __m256i y, __m256i z) {
+                    const __m256i ones = _mm256_set1_epi32(-1);
+                    switch (round) {
+                        case 0: return _mm256_xor_si256(_mm256_xor_si256(x, y), z);
+                        case 1: return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z));
+                        case 2: return _mm256_xor_si256(_mm256_or_si256(x, _mm256_xor_si256(y, ones)), z);
+                        case 3: return _mm256_or_si256(_mm256_and_si256(x, z), _mm256_andnot_si256(z, y));
+                        default: return _mm256_xor_si256(x, _mm256_or_si256(y, _mm256_xor_si256(z, ones)));
+                    }
+                }
+            }
+
+            __attribute__((target("avx2")))
+            void compress8Way(uint32_t state[40], const uint8_t* const blocks[8]) {
+                __m256i s[5];
+                for (int i = 0; i < 5; ++i) {
+                    s[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 8 * i));
+                }
+                __m256i x[16];
+                for (int i = 0; i < 16; ++i) {
+                    x[i] = load8(blocks, 4 * i);
+                }
+
+                __m256i al = s[0], bl = s[1], cl = s[2], dl = s[3], el = s[4];
+                __m256i ar = al, br = bl, cr = cl, dr = dl, er = el;
+
+#pragma GCC unroll 80
+                for (int j = 0; j < 80; ++j) {
+                    int round = j / 16;
+                    __m256i t = _mm256_add_epi32(al, _mm256_add_epi32(boolean8(round, bl, cl, dl),
+                                _mm256_add_epi32(x[LEFT_WORD[j]], _mm256_set1_epi32(static_cast<int>(LEFT_K[round])))));
+                    t = _mm256_add_epi32(rotl8(t, LEFT_SHIFT[j]), el);
+                    al = el; el = dl; dl = rotl8(cl, 10); cl = bl; bl = t;
+
+                    t = _mm256_add_epi32(ar, _mm256_add_epi32(boolean8(4 - round, br, cr, dr),
+                        _mm256_add_epi32(x[RIGHT_WORD[j]], _mm256_set1_epi32(static_cast<int>(RIGHT_K[round])))));
+                    t = _mm256_add_epi32(rotl8(t, RIGHT_SHIFT[j]), er);
+                    ar = er; er = dr; dr = rotl8(cr, 10); cr = br; br = t;
+                }
+
+                __m256i out[5] = {
+                    _mm256_add_epi32(s[1], _mm256_add_epi32(cl, dr)),
+                    _mm256_add_epi32(s[2], _mm256_add_epi32(dl, er)),
+                    _mm256_add_epi32(s[3], _mm256_add_epi32(el, ar)),
+                    _mm256_add_epi32(s[4], _mm256_add_epi32(al, br)),
+                    _mm256_add_epi32(s[0], _mm256_add_epi32(bl, cr))
+                };
+                for (int i = 0; i < 5; ++i) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 8 * i), out[i]);
+                }
+            }
+
+#else // !CRYPTO_RIPEMD160_X86
+
+            namespace {
+                template <size_t LANES>
+                void compressLanesScalar(uint32_t* state, const uint8_t* const blocks[LANES]) {
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        uint32_t s[5];
+                        for (int i = 0; i < 5; ++i) s[i] = state[i * LANES + lane];
+                        compress(s, blocks[lane], 1);
+                        for (int i = 0; i < 5; ++i) state[i * LANES + lane] = s[i];
+                    }
+                }
+            }
+
+            void compress4Way(uint32_t state[20], const uint8_t* const blocks[4]) {
+                compressLanesScalar<4>(state, blocks);
+            }
+
+            void compress8Way(uint32_t state[40], const uint8_t* const blocks[8]) {
+                compressLanesScalar<8>(state, blocks);
+            }
+
+#endif // CRYPTO_RIPEMD160_X86
+
+            size_t laneWidth() {
+                // The portable hash backend pins SHA-256 to scalar; RIPEMD-160 follows it
+                if (Transform::active() == Transform::Implementation::SCALAR) {
+                    return 1;
+                }
+                const CpuFeatures& cpu = CpuFeatures::get();
+                if (cpu.avx2) return 8;
+                if (cpu.sse41) return 4;
+                return 1;
+            }
+
+            void storeDigest(const uint32_t state[5], uint8_t out[20]) {
+                for (int i = 0; i < 5; ++i) {
+                    out[4 * i] = static_cast<uint8_t>(state[i]);
+                    out[4 * i + 1] = static_cast<uint8_t>(state[i] >> 8);
+                    out[4 * i + 2] = static_cast<uint8_t>(state[i] >> 16);
+                    out[4 * i + 3] = static_cast<uint8_t>(state[i] >> 24);
+                }
+            }
+
+            // ---------------------------------------------------------------
+            // FIXED 32-BYTE INPUTS
+            // ---------------------------------------------------------------
+
+            namespace {
+                // 0x80 marker after the 32 message bytes and a 256-bit little-endian length
+                inline void initPaddedBlock(uint8_t block[64]) {
+                    std::memset(block + 32, 0, 32);
+                    block[32] = 0x80;
+                    block[57] = 0x01;
+                }
+
+                template <size_t LANES>
+                void hash32Lanes(void (*kernel)(uint32_t*, const uint8_t* const*), uint8_t* out, const uint8_t* in, size_t count) {
+                    uint8_t blocks[LANES][64];
+                    const uint8_t* pointers[LANES];
+                    uint32_t state[5 * LANES];
+                    uint32_t laneState[5];
+
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        initPaddedBlock(blocks[lane]);
+                        pointers[lane] = blocks[lane];
+                    }
+                    for (; count >= LANES; count -= LANES, in += 32 * LANES, out += 20 * LANES) {
+                        for (size_t lane = 0; lane < LANES; ++lane) {
+                            std::memcpy(blocks[lane], in + 32 * lane, 32);
+                        }
+                        for (size_t w = 0; w < 5; ++w) {
+                            for (size_t lane = 0; lane < LANES; ++lane) {
+                                state[w * LANES + lane] = INITIAL_STATE[w];
+                            }
+                        }
+                        kernel(state, pointers);
+                        for (size_t lane = 0; lane < LANES; ++lane) {
+                            for (size_t w = 0; w < 5; ++w) laneState[w] = state[w * LANES + lane];
+                            storeDigest(laneState, out + 20 * lane);
+                        }
+                    }
+                }
+            }
+
+            void hash32(uint8_t* out, const uint8_t* in, size_t count) {
+                size_t width = laneWidth();
+                size_t wide = 0;
+                if (width == 8) {
+                    wide = count - count % 8;
+                    hash32Lanes<8>(compress8Way, out, in, wide);
+                } else if (width == 4) {
+                    wide = count - count % 4;
+                    hash32Lanes<4>(compress4Way, out, in, wide);
+                }
+
+                uint8_t block[64];
+                initPaddedBlock(block);
+                for (size_t i = wide; i < count; ++i) {
+                    uint32_t state[5];
+                    std::memcpy(block, in + 32 * i, 32);
+                    std::memcpy(state, INITIAL_STATE, sizeof(state));
+                    compress(state, block, 1);
+                    storeDigest(state, out + 20 * i);
+                }
+            }
+
+        } // namespace Ripemd160Transform
+    } // namespace SHA256
+} // namespace Crypto
@@ -0,0 +1,569 @@
+#include "crypto/sha256_transform.h"
+#include "crypto/cpu_features.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CRYPTO_SHA256_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Crypto {
+    namespace SHA256 {
+        namespace Transform {
+
+            const uint32_t INITIAL_STATE[8] = {
+                0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+            };
+
+            namespace {
+                alignas(64) const uint32_t K[64] = {
+                    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+                };
+
+                inline uint32_t readBE32(const uint8_t* p) {
+                    uint32_t v;
+                    std::memcpy(&v, p, 4);
+                    return __builtin_bswap32(v);
+                }
+
+                inline void writeBE32(uint8_t* p, uint32_t v) {
+                    v = __builtin_bswap32(v);
+                    std::memcpy(p, &v, 4);
+                }
+
+                inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+                std::atomic<Implementation>& activeSlot() {
+                    static std::atomic<Implementation> slot{detect()};
+                    return slot;
+                }
+            }
+
+            // ---------------------------------------------------------------
+            // SCALAR
+            // ---------------------------------------------------------------
+
+            void compressScalar(uint32_t state[8], const uint8_t* data, size_t blocks) {
+                while (blocks--) {
+                    uint32_t w[64];
+                    for (int i = 0; i < 16; ++i) {
+                        w[i] = readBE32(data + 4 * i);
+                    }
+                    for (int i = 16; i < 64; ++i) {
+                        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+                    }
+
+                    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+                    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+                    for (int i = 0; i < 64; ++i) {
+                        uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+                        uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                        h = g; g = f; f = e; e = d + t1;
+                        d = c; c = b; b = a; a = t1 + t2;
+                    }
+                    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+                    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+                    data += 64;
+                }
+            }
+
+#ifdef CRYPTO_SHA256_X86
+
+            // ---------------------------------------------------------------
+            // SHA-NI (Intel SHA extensions, one stream, four rounds per pair of instructions)
+            // ---------------------------------------------------------------
+
+            __attribute__((target("sha,sse4.1")))
+            void compressShaNi(uint32_t state[8], const uint8_t* data, size_t blocks) {
+                const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+                __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+                __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+                tmp = _mm_shuffle_epi32(tmp, 0xB1);                 // CDAB
+                state1 = _mm_shuffle_epi32(state1, 0x1B);           // EFGH
+                __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);   // ABEF
+                state1 = _mm_blend_epi16(state1, tmp, 0xF0);        // CDGH
+
+                while (blocks--) {
+                    const __m128i abefSave = state0;
+                    const __m128i cdghSave = state1;
+                    __m128i m[4];
+
+#pragma GCC unroll 16
+                    for (int i = 0; i < 16; ++i) {
+                        if (i < 4) {
+                            m[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byteSwap);
+                        }
+                        __m128i msg = _mm_add_epi32(m[i & 3], _mm_load_si128(reinterpret_cast<const __m128i*>(&K[4 * i])));
+                        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+                        // W[i+1] = msg2(msg1(W[i-3], W[i-2]) + W[i-1..i] shifted, W[i])
+                        if (i >= 3 && i <= 14) {
+                            __m128i& next = m[(i + 1) & 3];
+                            next = _mm_add_epi32(next, _mm_alignr_epi8(m[i & 3], m[(i - 1) & 3], 4));
+                            next = _mm_sha256msg2_epu32(next, m[i & 3]);
+                        }
+
+                        msg = _mm_shuffle_epi32(msg, 0x0E);
+                        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+                        if (i >= 1 && i <= 12) {
+                            m[(i - 1) & 3] = _mm_sha256msg1_epu32(m[(i - 1) & 3], m[i & 3]);
+                        }
+                    }
+
+                    state0 = _mm_add_epi32(state0, abefSave);
+                    state1 = _mm_add_epi32(state1, cdghSave);
+                    data += 64;
+                }
+
+                tmp = _mm_shuffle_epi32(state0, 0x1B);              // FEBA
+                state1 = _mm_shuffle_epi32(state1, 0xB1);           // DCHG
+                state0 = _mm_blend_epi16(tmp, state1, 0xF0);        // DCBA
+                state1 = _mm_alignr_epi8(state1, tmp, 8);           // HGFE
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+            }
+
+            // ---------------------------------------------------------------
+            // SSE4.1 (4 lanes of 32-bit words)
+            // ---------------------------------------------------------------
+
+            namespace {
+                __attribute__((target("sse4.1"))) inline __m128i ror4(__m128i x, int n) {
+                    return _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n));
+                }
+
+                __attribute__((target("sse4.1"))) inline __m128i load4(const uint8_t* const blocks[4], int offset) {
+                    return _mm_set_epi32(static_cast<int>(readBE32(blocks[3] + offset)), static_cast<int>(readBE32(blocks[2] + offset)),
+                                         static_cast<int>(readBE32(blocks[1] + offset)), static_cast<int>(readBE32(blocks[0] + offset)));
+                }
+            }
+
+            __attribute__((target("sse4.1")))
+            void compress4Way(uint32_t state[32], const uint8_t* const blocks[4]) {
+                __m128i s[8];
+                for (int i = 0; i < 8; ++i) {
+                    s[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4 * i));
+                }
+                __m128i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+                __m128i w[16];
+
+                for (int i = 0; i < 64; ++i) {
+                    __m128i wi;
+                    if (i < 16) {
+                        wi = w[i] = load4(blocks, 4 * i);
+                    } else {
+                        __m128i w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+                        __m128i s0 = _mm_xor_si128(_mm_xor_si128(ror4(w15, 7), ror4(w15, 18)), _mm_srli_epi32(w15, 3));
+                        __m128i s1 = _mm_xor_si128(_mm_xor_si128(ror4(w2, 17), ror4(w2, 19)), _mm_srli_epi32(w2, 10));
+                        wi = w[i & 15] = _mm_add_epi32(_mm_add_epi32(w[i & 15], s0), _mm_add_epi32(w[(i - 7) & 15], s1));
+                    }
+                    __m128i bigS1 = _mm_xor_si128(_mm_xor_si128(ror4(e, 6), ror4(e, 11)), ror4(e, 25));
+                    __m128i ch = _mm_xor_si128(_mm_and_si128(e, f), _mm_andnot_si128(e, g));
+                    __m128i t1 = _mm_add_epi32(_mm_add_epi32(h, bigS1), _mm_add_epi32(ch, _mm_add_epi32(_mm_set1_epi32(static_cast<int>(K[i])), wi)));
+                    __m128i bigS0 = _mm_xor_si128(_mm_xor_si128(ror4(a, 2), ror4(a, 13)), ror4(a, 22));
+                    __m128i maj = _mm_or_si128(_mm_and_si128(a, b), _mm_and_si128(c, _mm_or_si128(a, b)));
+                    __m128i t2 = _mm_add_epi32(bigS0, maj);
+                    h = g; g = f; f = e; e = _mm_add_epi32(d, t1);
+                    d = c; c = b; b = a; a = _mm_add_epi32(t1, t2);
+                }
+
+                __m128i out[8] = {a, b, c, d, e, f, g, h};
+                for (int i = 0; i < 8; ++i) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4 * i), _mm_add_epi32(s[i], out[i]));
+                }
+            }
+
+            // ---------------------------------------------------------------
+            // AVX2 (8 lanes of 32-bit words)
+            // ---------------------------------------------------------------
+
+            namespace {
+                __attribute__((target("avx2"))) inline __m256i ror8(__m256i x, int n) {
+                    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+                }
+
+                __attribute__((target("avx2"))) inline __m256i load8(const uint8_t* const blocks[8], int offset) {
+                    return _mm256_set_epi32(static_cast<int>(readBE32(blocks[7] + offset)), static_cast<int>(readBE32(blocks[6] + offset)),
+                                            static_cast<int>(readBE32(blocks[5] + offset)), static_cast<int>(readBE32(blocks[4] + offset)),
+                                            static_cast<int>(readBE32(blocks[3] + offset)), static_cast<int>(readBE32(blocks[2] + offset)),
+                                            static_cast<int>(readBE32(blocks[1] + offset)), static_cast<int>(readBE32(blocks[0] + offset)));
+                }
+            }
+
+            __attribute__((target("avx2")))
+            void compress8Way(uint32_t state[64], const uint8_t* const blocks[8]) {
+                __m256i s[8];
+                for (int i = 0; i < 8; ++i) {
+                    s[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 8 * i));
+                }
+                __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+                __m256i w[16];
+
+                for (int i = 0; i < 64; ++i) {
+                    __m256i wi;
+                    if (i < 16) {
+                        wi = w[i] = load8(blocks, 4 * i);
+                    } else {
+                        __m256i w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+                        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ror8(w15, 7), ror8(w15, 18)), _mm256_srli_epi32(w15, 3));
+                        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ror8(w2, 17), ror8(w2, 19)), _mm256_srli_epi32(w2, 10));
+                        wi = w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], s0), _mm256_add_epi32(w[(i - 7) & 15], s1));
+                    }
+                    __m256i bigS1 = _mm256_xor_si256(_mm256_xor_si256(ror8(e, 6), ror8(e, 11)), ror8(e, 25));
+                    __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+                    __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, bigS1), _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(K[i])), wi)));
+                    __m256i bigS0 = _mm256_xor_si256(_mm256_xor_si256(ror8(a, 2), ror8(a, 13)), ror8(a, 22));
+                    __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+                    __m256i t2 = _mm256_add_epi32(bigS0, maj);
+                    h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+                    d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+                }
+
+                __m256i out[8] = {a, b, c, d, e, f, g, h};
+                for (int i = 0; i < 8; ++i) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 8 * i), _mm256_add_epi32(s[i], out[i]));
+                }
+            }
+
+#else // !CRYPTO_SHA256_X86
+
+            // Portable builds route every kernel through the scalar rounds
+
+            void compressShaNi(uint32_t state[8], const uint8_t* data, size_t blocks) {
+                compressScalar(state, data, blocks);
+            }
+
+            namespace {
+                template <size_t LANES>
+                void compressLanesScalar(uint32_t* state, const uint8_t* const blocks[LANES]) {
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        uint32_t s[8];
+                        for (int i = 0; i < 8; ++i) s[i] = state[i * LANES + lane];
+                        compressScalar(s, blocks[lane], 1);
+                        for (int i = 0; i < 8; ++i) state[i * LANES + lane] = s[i];
+                    }
+                }
+            }
+
+            void compress4Way(uint32_t state[32], const uint8_t* const blocks[4]) {
+                compressLanesScalar<4>(state, blocks);
+            }
+
+            void compress8Way(uint32_t state[64], const uint8_t* const blocks[8]) {
+                compressLanesScalar<8>(state, blocks);
+            }
+
+#endif // CRYPTO_SHA256_X86
+
+            // ---------------------------------------------------------------
+            // DISPATCH
+            // ---------------------------------------------------------------
+
+            bool isSupported(Implementation impl) {
+                const CpuFeatures& cpu = CpuFeatures::get();
+                switch (impl) {
+                    case Implementation::SCALAR: return true;
+                    case Implementation::SSE41: return cpu.sse41;
+                    case Implementation::AVX2: return cpu.avx2;
+                    case Implementation::SHANI: return cpu.shaNi;
+                    default: return false;
+                }
+            }
+
+            Implementation detect() {
+                if (isSupported(Implementation::SHANI)) return Implementation::SHANI;
+                if (isSupported(Implementation::AVX2)) return Implementation::AVX2;
+                if (isSupported(Implementation::SSE41)) return Implementation::SSE41;
+                return Implementation::SCALAR;
+            }
+
+            Implementation active() {
+                return activeSlot().load(std::memory_order_relaxed);
+            }
+
+            bool select(Implementation impl) {
+                if (!isSupported(impl)) {
+                    return false;
+                }
+                activeSlot().store(impl, std::memory_order_relaxed);
+                return true;
+            }
+
+            const char* implementationName(Implementation impl) {
+                switch (impl) {
+                    case Implementation::SCALAR: return "scalar";
+                    case Implementation::SSE41: return "sse4.1-4way";
+                    case Implementation::AVX2: return "avx2-8way";
+                    case Implementation::SHANI: return "sha-ni";
+                    default: return "unknown";
+                }
+            }
+
+            void compress(uint32_t state[8], const uint8_t* data, size_t blocks) {
+                if (active() == Implementation::SHANI) {
+                    compressShaNi(state, data, blocks);
+                } else {
+                    compressScalar(state, data, blocks);
+                }
+            }
+
+            size_t laneWidth() {
+                switch (active()) {
+                    case Implementation::AVX2: return 8;
+                    case Implementation::SSE41: return 4;
+                    default: return 1;
+                }
+            }
+
+            void storeDigest(const uint32_t state[8], uint8_t out[32]) {
+                for (int i = 0; i < 8; ++i) {
+                    writeBE32(out + 4 * i, state[i]);
+                }
+            }
+
+            // ---------------------------------------------------------------
+            // FIXED 64-BYTE DOUBLE HASH
+            // ---------------------------------------------------------------
+
+            namespace {
+                // Second block of a 64-byte message: 0x80 marker and a 512-bit length
+                alignas(64) const uint8_t PAD_64[64] = {
+                    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x00
+                };
+
+                // Lay out a 32-byte digest as a complete single-block message
+                inline void padDigestBlock(const uint32_t state[8], uint8_t block[64]) {
+                    storeDigest(state, block);
+                    std::memset(block + 32, 0, 32);
+                    block[32] = 0x80;
+                    block[62] = 0x01;
+                }
+
+                void sha256d64Single(uint8_t* out, const uint8_t* in) {
+                    uint32_t state[8];
+                    uint8_t block[64];
+                    std::memcpy(state, INITIAL_STATE, sizeof(state));
+                    compress(state, in, 1);
+                    compress(state, PAD_64, 1);
+                    padDigestBlock(state, block);
+                    std::memcpy(state, INITIAL_STATE, sizeof(state));
+                    compress(state, block, 1);
+                    storeDigest(state, out);
+                }
+
+                template <size_t LANES>
+                void sha256d64Lanes(void (*kernel)(uint32_t*, const uint8_t* const*), uint8_t* out, const uint8_t* in) {
+                    uint32_t state[8 * LANES];
+                    const uint8_t* blocks[LANES];
+                    uint8_t second[LANES][64];
+                    uint32_t laneState[8];
+
+                    auto resetAll = [&]() {
+                        for (size_t w = 0; w < 8; ++w) {
+                            for (size_t lane = 0; lane < LANES; ++lane) {
+                                state[w * LANES + lane] = INITIAL_STATE[w];
+                            }
+                        }
+                    };
+
+                    resetAll();
+                    for (size_t lane = 0; lane < LANES; ++lane) blocks[lane] = in + 64 * lane;
+                    kernel(state, blocks);
+                    for (size_t lane = 0; lane < LANES; ++lane) blocks[lane] = PAD_64;
+                    kernel(state, blocks);
+
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        for (size_t w = 0; w < 8; ++w) laneState[w] = state[w * LANES + lane];
+                        padDigestBlock(laneState, second[lane]);
+                        blocks[lane] = second[lane];
+                    }
+                    resetAll();
+                    kernel(state, blocks);
+
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        for (size_t w = 0; w < 8; ++w) laneState[w] = state[w * LANES + lane];
+                        storeDigest(laneState, out + 32 * lane);
+                    }
+                }
+            }
+
+            void sha256d64(uint8_t* out, const uint8_t* in, size_t count) {
+                Implementation impl = active();
+                if (impl == Implementation::AVX2) {
+                    for (; count >= 8; count -= 8, in += 8 * 64, out += 8 * 32) {
+                        sha256d64Lanes<8>(compress8Way, out, in);
+                    }
+                }
+                if (impl == Implementation::AVX2 || impl == Implementation::SSE41) {
+                    for (; count >= 4; count -= 4, in += 4 * 64, out += 4 * 32) {
+                        sha256d64Lanes<4>(compress4Way, out, in);
+                    }
+                }
+                for (; count > 0; --count, in += 64, out += 32) {
+                    sha256d64Single(out, in);
+                }
+            }
+
+            // ---------------------------------------------------------------
+            // BATCH DRIVER
+            // ---------------------------------------------------------------
+
+            namespace {
+                // One message laid out as its whole blocks plus a padded tail copy
+                struct Lane {
+                    const uint8_t* message = nullptr;
+                    size_t fullBlocks = 0;
+                    size_t totalBlocks = 0;
+                    size_t nextBlock = 0;
+                    size_t index = 0;
+                    bool secondPass = false;
+                    uint8_t tail[128];
+
+                    void start(const uint8_t* data, size_t length) {
+                        message = data;
+                        fullBlocks = length / 64;
+                        size_t remainder = length % 64;
+                        size_t tailBlocks = remainder + 9 <= 64 ? 1 : 2;
+
+                        std::memset(tail, 0, sizeof(tail));
+                        if (remainder) {
+                            std::memcpy(tail, data + fullBlocks * 64, remainder);
+                        }
+                        tail[remainder] = 0x80;
+                        uint64_t bits = static_cast<uint64_t>(length) * 8;
+                        for (int i = 0; i < 8; ++i) {
+                            tail[tailBlocks * 64 - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+                        }
+
+                        totalBlocks = fullBlocks + tailBlocks;
+                        nextBlock = 0;
+                    }
+
+                    const uint8_t* block() const {
+                        return nextBlock < fullBlocks ? message + 64 * nextBlock : tail + 64 * (nextBlock - fullBlocks);
+                    }
+                };
+
+                const uint8_t IDLE_BLOCK[64] = {};
+
+                // Each lane pulls the next pending message as soon as it finishes, so
+                // mixed-length batches keep every lane busy until the queue drains.
+                template <size_t LANES>
+                void hashLanes(void (*kernel)(uint32_t*, const uint8_t* const*),
+                               const ByteView* inputs, Digest256* outputs, size_t count, bool doubleHash) {
+                    uint32_t state[8 * LANES];
+                    const uint8_t* blocks[LANES];
+                    Lane lanes[LANES];
+                    bool busy[LANES];
+                    size_t pending = 0;
+                    size_t busyCount = 0;
+
+                    auto resetState = [&](size_t lane) {
+                        for (size_t w = 0; w < 8; ++w) {
+                            state[w * LANES + lane] = INITIAL_STATE[w];
+                        }
+                    };
+
+                    auto refill = [&](size_t lane) {
+                        if (pending >= count) {
+                            busy[lane] = false;
+                            return;
+                        }
+                        lanes[lane].start(inputs[pending].data(), inputs[pending].size());
+                        lanes[lane].index = pending++;
+                        lanes[lane].secondPass = false;
+                        resetState(lane);
+                        busy[lane] = true;
+                        ++busyCount;
+                    };
+
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        refill(lane);
+                    }
+
+                    while (busyCount > 0) {
+                        for (size_t lane = 0; lane < LANES; ++lane) {
+                            blocks[lane] = busy[lane] ? lanes[lane].block() : IDLE_BLOCK;
+                        }
+                        kernel(state, blocks);
+
+                        for (size_t lane = 0; lane < LANES; ++lane) {
+                            if (!busy[lane] || ++lanes[lane].nextBlock < lanes[lane].totalBlocks) {
+                                continue;
+                            }
+                            uint32_t finished[8];
+                            for (size_t w = 0; w < 8; ++w) {
+                                finished[w] = state[w * LANES + lane];
+                            }
+                            Digest256 digest;
+                            storeDigest(finished, digest.data());
+
+                            if (doubleHash && !lanes[lane].secondPass) {
+                                // The 32-byte digest is copied into the tail, so it can be re-queued in place
+                                lanes[lane].start(digest.data(), digest.size());
+                                lanes[lane].secondPass = true;
+                                resetState(lane);
+                                continue;
+                            }
+                            outputs[lanes[lane].index] = digest;
+                            --busyCount;
+                            refill(lane);
+                        }
+                    }
+                }
+
+                void hashSequential(const ByteView* inputs, Digest256* outputs, size_t count, bool doubleHash) {
+                    Lane lane;
+                    for (size_t i = 0; i < count; ++i) {
+                        uint32_t state[8];
+                        std::memcpy(state, INITIAL_STATE, sizeof(state));
+                        lane.start(inputs[i].data(), inputs[i].size());
+                        compress(state, lane.message, lane.fullBlocks);
+                        compress(state, lane.tail, lane.totalBlocks - lane.fullBlocks);
+                        storeDigest(state, outputs[i].data());
+
+                        if (doubleHash) {
+                            std::memcpy(state, INITIAL_STATE, sizeof(state));
+                            lane.start(outputs[i].data(), outputs[i].size());
+                            compress(state, lane.tail, 1);
+                            storeDigest(state, outputs[i].data());
+                        }
+                    }
+                }
+            }
+
+            void hashBatch(const ByteView* inputs, Digest256* outputs, size_t count, bool doubleHash) {
+                switch (active()) {
+                    case Implementation::AVX2:
+                        hashLanes<8>(compress8Way, inputs, outputs, count, doubleHash);
+                        break;
+                    case Implementation::SSE41:
+                        hashLanes<4>(compress4Way, inputs, outputs, count, doubleHash);
+                        break;
+                    default:
+                        hashSequential(inputs, outputs, count, doubleHash);
+                        break;
+                }
+            }
+
+        } // namespace Transform
+    } // namespace SHA256
+} // namespace Crypto
@@ -0,0 +1,168 @@
+#include "crypto/sha512_transform.h"
+#include "crypto/cpu_features.h"
+#include "crypto/sha256_transform.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CRYPTO_SHA512_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Crypto {
+    namespace SHA256 {
+        namespace Sha512Transform {
+
+            const uint64_t INITIAL_STATE[8] = {
+                0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+                0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+            };
+
+            namespace {
+                alignas(64) const uint64_t K[80] = {
+                    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+                    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+                    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+                    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+                    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+                    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+                    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+                    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+                    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+                    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+                    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+                    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+                    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+                    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+                    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+                    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+                    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+                    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+                    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+                    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+                };
+
+                inline uint64_t readBE64(const uint8_t* p) {
+                    uint64_t v;
+                    std::memcpy(&v, p, 8);
+                    return __builtin_bswap64(v);
+                }
+
+                inline uint64_t rotr(uint64_t x, int n) { return (x >> n) | (x << (64 - n)); }
+            }
+
+            // ---------------------------------------------------------------
+            // SCALAR
+            // ---------------------------------------------------------------
+
+            void compress(uint64_t state[8], const uint8_t* data, size_t blocks) {
+                while (blocks--) {
+                    uint64_t w[80];
+                    for (int i = 0; i < 16; ++i) {
+                        w[i] = readBE64(data + 8 * i);
+                    }
+                    for (int i = 16; i < 80; ++i) {
+                        uint64_t s0 = rotr(w[i - 15], 1) ^ rotr(w[i - 15], 8) ^ (w[i - 15] >> 7);
+                        uint64_t s1 = rotr(w[i - 2], 19) ^ rotr(w[i - 2], 61) ^ (w[i - 2] >> 6);
+                        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+                    }
+
+                    uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+                    uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+                    for (int i = 0; i < 80; ++i) {
+                        uint64_t t1 = h + (rotr(e, 14) ^ rotr(e, 18) ^ rotr(e, 41)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+                        uint64_t t2 = (rotr(a, 28) ^ rotr(a, 34) ^ rotr(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+                        h = g; g = f; f = e; e = d + t1;
+                        d = c; c = b; b = a; a = t1 + t2;
+                    }
+
+                    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+                    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+                    data += 128;
+                }
+            }
+
+#ifdef CRYPTO_SHA512_X86
+
+            // ---------------------------------------------------------------
+            // AVX2 (4 lanes of 64-bit words)
+            // ---------------------------------------------------------------
+
+            namespace {
+                __attribute__((target("avx2"))) inline __m256i ror4x64(__m256i x, int n) {
+                    return _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - n));
+                }
+
+                __attribute__((target("avx2"))) inline __m256i load4x64(const uint8_t* const blocks[4], int offset) {
+                    return _mm256_set_epi64x(static_cast<long long>(readBE64(blocks[3] + offset)), static_cast<long long>(readBE64(blocks[2] + offset)),
+                                             static_cast<long long>(readBE64(blocks[1] + offset)), static_cast<long long>(readBE64(blocks[0] + offset)));
+                }
+            }
+
+            __attribute__((target("avx2")))
+            void compress4Way(uint64_t state[32], const uint8_t* const blocks[4]) {
+                __m256i s[8];
+                for (int i = 0; i < 8; ++i) {
+                    s[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 4 * i));
+                }
+                __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+                __m256i w[16];
+
+                for (int i = 0; i < 80; ++i) {
+                    __m256i wi;
+                    if (i < 16) {
+                        wi = w[i] = load4x64(blocks, 8 * i);
+                    } else {
+                        __m256i w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+                        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ror4x64(w15, 1), ror4x64(w15, 8)), _mm256_srli_epi64(w15, 7));
+                        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ror4x64(w2, 19), ror4x64(w2, 61)), _mm256_srli_epi64(w2, 6));
+                        wi = w[i & 15] = _mm256_add_epi64(_mm256_add_epi64(w[i & 15], s0), _mm256_add_epi64(w[(i - 7) & 15], s1));
+                    }
+                    __m256i bigS1 = _mm256_xor_si256(_mm256_xor_si256(ror4x64(e, 14), ror4x64(e, 18)), ror4x64(e, 41));
+                    __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+                    __m256i t1 = _mm256_add_epi64(_mm256_add_epi64(h, bigS1),
+                                                  _mm256_add_epi64(ch, _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(K[i])), wi)));
+                    __m256i bigS0 = _mm256_xor_si256(_mm256_xor_si256(ror4x64(a, 28), ror4x64(a, 34)), ror4x64(a, 39));
+                    __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+                    __m256i t2 = _mm256_add_epi64(bigS0, maj);
+                    h = g; g = f; f = e; e = _mm256_add_epi64(d, t1);
+                    d = c; c = b; b = a; a = _mm256_add_epi64(t1, t2);
+                }
+
+                __m256i out[8] = {a, b, c, d, e, f, g, h};
+                for (int i = 0; i < 8; ++i) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 4 * i), _mm256_add_epi64(s[i], out[i]));
+                }
+            }
+
+#else // !CRYPTO_SHA512_X86
+
+            void compress4Way(uint64_t state[32], const uint8_t* const blocks[4]) {
+                for (size_t lane = 0; lane < 4; ++lane) {
+                    uint64_t s[8];
+                    for (int i = 0; i < 8; ++i) s[i] = state[i * 4 + lane];
+                    compress(s, blocks[lane], 1);
+                    for (int i = 0; i < 8; ++i) state[i * 4 + lane] = s[i];
+                }
+            }
+
+#endif // CRYPTO_SHA512_X86
+
+            size_t laneWidth() {
+                // The portable hash backend pins SHA-256 to scalar; SHA-512 follows it
+                if (Transform::active() == Transform::Implementation::SCALAR) {
+                    return 1;
+                }
+                return CpuFeatures::get().avx2 ? 4 : 1;
+            }
+
+            void storeDigest(const uint64_t state[8], uint8_t out[64]) {
+                for (int i = 0; i < 8; ++i) {
+                    uint64_t v = __builtin_bswap64(state[i]);
+                    std::memcpy(out + 8 * i, &v, 8);
+                }
+            }
+
+        } // namespace Sha512Transform
+    } // namespace SHA256
+} // namespace Crypto
@@ -2,7 +2,13 @@
 #include "utils/Config.h"
 #include <string>
 #include <iostream>
+#include <algorithm>
 #include "crypto/hash.h"
+#include "crypto/hash_backend.h"
+#include "crypto/miner.h"
+#include "utils/JSONHelper.h"
+#include "utils/Metrics.h"
+#include "utils/Trace.h"
 int main() {
     using namespace Crypto::Utils;
 
@@ -15,17 +21,47 @@ int main() {
         LOG_ERROR("Failed to load configuration from " + configPath);
         return 1;
     }
+    logger->configure();
+    Metrics::configure();
+    Trace::configure();
 
-    std::string networkName = Config::getString("blockchain.networkName");
-    int targetBlockTime = Config::getInt("blockchain.targetBlockTime");
-    int maxBlockSize = Config::getInt("blockchain.maxBlockSize");
+    static const ConfigKey hotReload("config.hotReload");
+    if (hotReload.getBool()) {
+        try {
+            Config::watch(configPath);
+        } catch (const std::exception& e) {
+            LOG_WARNING("Config hot reload unavailable: ", e.what());
+        }
+    }
+    Config::subscribe([logger](const ConfigSnapshot& previous, const ConfigSnapshot& next) {
+        if (previous.mining.threadCount != next.mining.threadCount) {
+            LOG_INFO("Mining threads now ", next.mining.threadCount);
+        }
+        if (previous.network.maxConnections != next.network.maxConnections) {
+            LOG_INFO("Connection limit now ", next.network.maxConnections);
+        }
+        auto logging = next.document.find("logging");
+        auto previousLogging = previous.document.find("logging");
+        bool loggingChanged = (logging == next.document.end()) != (previousLogging == previous.document.end()) ||
+                              (logging != next.document.end() && *logging != *previousLogging);
+        if (loggingChanged) {
+            logger->configure();
+        }
+    });
+
+    // Held for the rest of main, so the references below outlive any reload
+    std::shared_ptr<const ConfigSnapshot> config = Config::settings();
+    const ConfigSnapshot& settings = *config;
+    const std::string& networkName = settings.blockchain.networkName;
+    int targetBlockTime = settings.blockchain.targetBlockTime;
+    int maxBlockSize = settings.blockchain.maxBlockSize;
 
-    int port = Config::getInt("network.port");
-    std::string bindAddress = Config::getString("network.bindAddress");
-    int maxConnections = Config::getInt("network.maxConnections");
+    int port = settings.network.port;
+    const std::string& bindAddress = settings.network.bindAddress;
+    int maxConnections = settings.network.maxConnections;
 
-    bool enableMining = Config::getBool("mining.enableMining");
-    int threadCount = Config::getInt("mining.threadCount");
+    bool enableMining = settings.mining.enableMining;
+    int threadCount = settings.mining.threadCount;
 
     LOG_INFO("Blockchain Network Name: " + networkName);
     LOG_INFO("Target Block Time: " + std::to_string(targetBlockTime));
@@ -38,9 +74,31 @@ int main() {
     LOG_INFO("Mining Enabled: " + std::string(enableMining ? "Yes" : "No"));
     LOG_INFO("Mining Threads: " + std::to_string(threadCount));
 
+    Crypto::SHA256::HashBackendRegistry::initialize();
+
     std::string data = "Hello Blockchain!";
     std::string hash = Crypto::SHA256::Hash::sha256(data);
     LOG_INFO("Hashed Data: " + hash);
 
+    if (enableMining) {
+        using namespace Crypto::SHA256;
+        const uint32_t demoBits = 0x1f00ffff;
+
+        Digest256 merkle = Hash::merkleRoot(std::vector<Digest256>{Hash::sha256dRaw(ByteView(data))});
+        BlockHeader header = Miner::makeHeader(1, Digest256{}, merkle,
+            static_cast<uint32_t>(JSONHelper::getCurrentTimestamp()), demoBits);
+
+        Miner miner(static_cast<size_t>(threadCount > 0 ? threadCount : 0));
+        MiningResult result = miner.mine(header, Miner::targetFromCompact(demoBits));
+        if (result.found) {
+            LOG_INFO("Mined Nonce: " + std::to_string(result.nonce) + " Hash: " + result.hash.toHex());
+        }
+        LOG_INFO("Mining Rate: " + std::to_string(static_cast<uint64_t>(result.totalHashes / std::max(result.seconds, 1e-9))) + " H/s");
+    }
+
+    Config::stopWatching();
+    Trace::finish();
+    Metrics::stopExport();
+    logger->shutdown();
     return 0;
 }
@@ -0,0 +1,261 @@
+#include "utils/BinaryLog.h"
+#include "utils/Logger.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRYPTO_BINARY_LOG_PAUSE() _mm_pause()
+#else
+#define CRYPTO_BINARY_LOG_PAUSE() ((void)0)
+#endif
+
+namespace Crypto {
+    namespace Utils {
+
+        std::atomic<bool> BinaryLog::active{false};
+
+        namespace {
+            struct ThreadBuffer {
+                std::atomic<bool> locked{false};
+                uint32_t thread = 0;
+                size_t used = 0;
+                size_t pending = 0;
+                uint8_t data[BinaryLog::THREAD_BUFFER_SIZE];
+
+                void lock() {
+                    while (locked.exchange(true, std::memory_order_acquire)) {
+                        CRYPTO_BINARY_LOG_PAUSE();
+                    }
+                }
+                void unlock() { locked.store(false, std::memory_order_release); }
+            };
+
+            // Lock order: `listMutex` before `sinkMutex` (registerFormat, open) and a thread
+            // buffer before `sinkMutex` (writeChunk); `listMutex` and a thread buffer are
+            // never held together
+            struct Registry {
+                std::mutex listMutex;
+                std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+                std::vector<std::vector<uint8_t>> formats;    // serialized FORMAT records, index = id - 1
+
+                std::mutex sinkMutex;
+                std::shared_ptr<LogSink> sink;
+
+                // Periodic flush, so records of rarely-logging threads reach the sink before a crash
+                std::mutex flusherMutex;
+                std::condition_variable flusherWake;
+                std::thread flusher;
+                bool flusherStopping = false;
+
+                std::atomic<uint32_t> nextThread{0};
+                std::atomic<uint64_t> oversized{0};
+            };
+
+            // Never destroyed: thread-exit flushes may run after static destructors
+            Registry& registry() {
+                static Registry* instance = new Registry();
+                return *instance;
+            }
+
+            template <typename T>
+            void putValue(std::vector<uint8_t>& out, T value) {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                out.insert(out.end(), bytes, bytes + sizeof(T));
+            }
+
+            void putText(std::vector<uint8_t>& out, const char* text) {
+                size_t length = BinaryLogFormat::StringCodec::clamp(std::strlen(text));
+                putValue(out, static_cast<uint16_t>(length));
+                out.insert(out.end(), text, text + length);
+            }
+
+            // Caller holds the buffer lock
+            void writeChunk(ThreadBuffer& buffer) {
+                if (buffer.used == 0) {
+                    return;
+                }
+                Registry& reg = registry();
+                uint8_t header[9];
+                header[0] = BinaryLogFormat::CHUNK;
+                uint32_t length = static_cast<uint32_t>(buffer.used);
+                std::memcpy(header + 1, &buffer.thread, 4);
+                std::memcpy(header + 5, &length, 4);
+                {
+                    std::lock_guard<std::mutex> lock(reg.sinkMutex);
+                    if (reg.sink) {
+                        reg.sink->write(reinterpret_cast<const char*>(header), sizeof(header));
+                        reg.sink->write(reinterpret_cast<const char*>(buffer.data), buffer.used);
+                    }
+                }
+                buffer.used = 0;
+            }
+
+            struct ThreadHolder {
+                std::shared_ptr<ThreadBuffer> buffer;
+
+                ~ThreadHolder() {
+                    if (!buffer) {
+                        return;
+                    }
+                    buffer->lock();
+                    writeChunk(*buffer);
+                    buffer->unlock();
+                    Registry& reg = registry();
+                    std::lock_guard<std::mutex> lock(reg.listMutex);
+                    for (auto it = reg.buffers.begin(); it != reg.buffers.end(); ++it) {
+                        if (*it == buffer) {
+                            reg.buffers.erase(it);
+                            break;
+                        }
+                    }
+                }
+            };
+
+            thread_local ThreadHolder holder;
+
+            ThreadBuffer& localBuffer() {
+                if (!holder.buffer) {
+                    Registry& reg = registry();
+                    holder.buffer = std::make_shared<ThreadBuffer>();
+                    holder.buffer->thread = reg.nextThread.fetch_add(1, std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock(reg.listMutex);
+                    reg.buffers.push_back(holder.buffer);
+                }
+                return *holder.buffer;
+            }
+        }
+
+        uint64_t BinaryLog::steadyNanos() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        uint8_t* BinaryLog::reserve(size_t size) {
+            if (!active.load(std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            if (size > THREAD_BUFFER_SIZE) {
+                registry().oversized.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            ThreadBuffer& buffer = localBuffer();
+            buffer.lock();
+            if (buffer.used + size > THREAD_BUFFER_SIZE) {
+                writeChunk(buffer);
+            }
+            buffer.pending = size;
+            return buffer.data + buffer.used;
+        }
+
+        void BinaryLog::commit() {
+            ThreadBuffer& buffer = *holder.buffer;
+            buffer.used += buffer.pending;
+            buffer.unlock();
+        }
+
+        uint32_t BinaryLog::registerFormat(LogLevel level, const char* format, const char* file, int line,
+                                           const uint8_t* types, size_t argCount) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> listLock(reg.listMutex);
+            uint32_t id = static_cast<uint32_t>(reg.formats.size() + 1);
+
+            std::vector<uint8_t> record;
+            record.push_back(BinaryLogFormat::FORMAT);
+            putValue(record, id);
+            record.push_back(static_cast<uint8_t>(level));
+            record.push_back(static_cast<uint8_t>(argCount));
+            record.insert(record.end(), types, types + argCount);
+            putText(record, format);
+            putText(record, file);
+            putValue(record, static_cast<uint32_t>(line));
+
+            // Written straight through so the definition precedes any chunk that uses it
+            {
+                std::lock_guard<std::mutex> sinkLock(reg.sinkMutex);
+                if (reg.sink) {
+                    reg.sink->write(reinterpret_cast<const char*>(record.data()), record.size());
+                }
+            }
+            reg.formats.push_back(std::move(record));
+            return id;
+        }
+
+        void BinaryLog::open(std::shared_ptr<LogSink> sink) {
+            close();
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> listLock(reg.listMutex);
+            std::lock_guard<std::mutex> sinkLock(reg.sinkMutex);
+
+            std::vector<uint8_t> header(BinaryLogFormat::MAGIC, BinaryLogFormat::MAGIC + sizeof(BinaryLogFormat::MAGIC));
+            putValue(header, steadyNanos());
+            putValue(header, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()));
+            sink->write(reinterpret_cast<const char*>(header.data()), header.size());
+            for (const auto& record : reg.formats) {
+                sink->write(reinterpret_cast<const char*>(record.data()), record.size());
+            }
+            reg.sink = std::move(sink);
+            active.store(true, std::memory_order_release);
+
+            std::lock_guard<std::mutex> flusherLock(reg.flusherMutex);
+            reg.flusherStopping = false;
+            reg.flusher = std::thread([&reg]() {
+                std::unique_lock<std::mutex> lock(reg.flusherMutex);
+                while (!reg.flusherWake.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS),
+                                                 [&reg]() { return reg.flusherStopping; })) {
+                    lock.unlock();
+                    flush();
+                    lock.lock();
+                }
+            });
+        }
+
+        void BinaryLog::open(const std::string& filePath) {
+            open(std::make_shared<FileSink>(filePath));
+        }
+
+        void BinaryLog::flush() {
+            Registry& reg = registry();
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+            {
+                std::lock_guard<std::mutex> lock(reg.listMutex);
+                buffers = reg.buffers;
+            }
+            for (const auto& buffer : buffers) {
+                buffer->lock();
+                writeChunk(*buffer);
+                buffer->unlock();
+            }
+            std::lock_guard<std::mutex> lock(reg.sinkMutex);
+            if (reg.sink) {
+                reg.sink->flush();
+            }
+        }
+
+        void BinaryLog::close() {
+            if (!active.exchange(false, std::memory_order_acq_rel)) {
+                return;
+            }
+            Registry& reg = registry();
+            {
+                std::lock_guard<std::mutex> flusherLock(reg.flusherMutex);
+                reg.flusherStopping = true;
+            }
+            reg.flusherWake.notify_all();
+            reg.flusher.join();
+            flush();
+            std::lock_guard<std::mutex> lock(reg.sinkMutex);
+            reg.sink.reset();
+        }
+
+        uint64_t BinaryLog::oversizedCount() {
+            return registry().oversized.load(std::memory_order_relaxed);
+        }
+
+    } // namespace Utils
+} // namespace Crypto
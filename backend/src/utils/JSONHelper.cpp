@@ -1,5 +1,7 @@
 #include "utils/JSONHelper.h"
 #include "utils/Logger.h"
+#include "utils/Metrics.h"
+#include "utils/Trace.h"
 
 #include <fstream>
 #include <sstream>
@@ -12,10 +14,31 @@ namespace Crypto {
 
         using json = nlohmann::json;
 
+        namespace {
+            struct JSONMetrics {
+                Histogram& parseString = Metrics::histogram("crypto_json_parse_duration_seconds", "JSON parse latency", "source=\"string\"");
+                Histogram& parseFile = Metrics::histogram("crypto_json_parse_duration_seconds", "JSON parse latency", "source=\"file\"");
+                Counter& parsedBytes = Metrics::counter("crypto_json_parse_bytes_total", "JSON text bytes parsed from strings");
+                Counter& parseErrors = Metrics::counter("crypto_json_errors_total", "JSON operations that failed", "operation=\"parse\"");
+                Counter& serializeErrors = Metrics::counter("crypto_json_errors_total", "JSON operations that failed", "operation=\"serialize\"");
+                Histogram& serialize = Metrics::histogram("crypto_json_serialize_duration_seconds", "JSON dump latency");
+            };
+
+            JSONMetrics& metrics() {
+                static JSONMetrics instance;
+                return instance;
+            }
+        }
+
         json JSONHelper::parseFromString(const std::string& jsonString) {
+            JSONMetrics& counters = metrics();
+            counters.parsedBytes.add(jsonString.size());
             try {
+                ScopedTimer timer(counters.parseString);
+                CRYPTO_TRACE_SCOPE("parseJSON", "bytes", static_cast<int64_t>(jsonString.size()));
                 return json::parse(jsonString);
             } catch (const json::parse_error& e) {
+                counters.parseErrors.increment();
                 std::string errorMsg = "Failed to parse JSON: " + std::string(e.what());
                 LOG_ERROR(errorMsg);
                 throw JSONException(errorMsg);
@@ -24,8 +47,11 @@ namespace Crypto {
 
         std::string JSONHelper::toString(const json& j, int indent) {
             try {
+                ScopedTimer timer(metrics().serialize);
+                CRYPTO_TRACE_SCOPE("serializeJSON");
                 return j.dump(indent);
             } catch (const json::exception& e) {
+                metrics().serializeErrors.increment();
                 std::string errorMsg = "Failed to convert JSON to string: " + std::string(e.what());
                 LOG_ERROR(errorMsg);
                 throw JSONException(errorMsg);
@@ -51,10 +77,13 @@ namespace Crypto {
                 if (!file.is_open()) {
                     throw JSONException("Cannot open file: " + filePath);
                 }
+                ScopedTimer timer(metrics().parseFile);
+                CRYPTO_TRACE_SCOPE("loadJSONFile");
                 json result;
                 file >> result;
                 return result;
             } catch (const std::exception& e) {
+                metrics().parseErrors.increment();
                 throw JSONException("Error loading JSON from file: " + std::string(e.what()));
             }
         }
@@ -104,42 +133,117 @@ namespace Crypto {
             }
         }
 
-        std::vector<std::string> JSONHelper::splitPath(const std::string& path) {
-            std::vector<std::string> parts;
-            std::stringstream ss(path);
-            std::string token;
-            while (std::getline(ss, token, '.')) {
-                if (!token.empty()) {
-                    parts.push_back(token);
+        namespace {
+            constexpr size_t NO_INDEX = static_cast<size_t>(-1);
+
+            // Array index for a path segment per RFC 6901 ("0" or digits without a leading zero)
+            size_t parseIndex(const std::string& part) {
+                if (part.empty() || part.size() > 18 || (part.size() > 1 && part[0] == '0')) {
+                    return NO_INDEX;
+                }
+                size_t index = 0;
+                for (char c : part) {
+                    if (c < '0' || c > '9') {
+                        return NO_INDEX;
+                    }
+                    index = index * 10 + static_cast<size_t>(c - '0');
                 }
+                return index;
+            }
+
+            std::vector<std::string> splitDotted(const std::string& path) {
+                std::vector<std::string> parts;
+                size_t start = 0;
+                while (start <= path.size()) {
+                    size_t end = path.find('.', start);
+                    if (end == std::string::npos) {
+                        end = path.size();
+                    }
+                    if (end > start) {
+                        parts.emplace_back(path, start, end - start);
+                    }
+                    start = end + 1;
+                }
+                return parts;
             }
-            return parts;
-        }
 
-        json JSONHelper::navigateToPath(const json& jsonObj, const std::vector<std::string>& pathParts) {
-            json current = jsonObj;
-            for (const auto& part : pathParts) {
-                if (!current.contains(part)) return nullptr;
-                current = current[part];
+            // One level down from `node`, or nullptr
+            const json* step(const json& node, const std::string& part, size_t index) {
+                if (node.is_object()) {
+                    auto it = node.find(part);
+                    return it != node.end() ? &*it : nullptr;
+                }
+                if (node.is_array() && index < node.size()) {
+                    return &node[index];
+                }
+                return nullptr;
             }
-            return current;
         }
 
-        json JSONHelper::getNestedValue(const json& jsonObj, const std::string& path) {
+        JSONPath::JSONPath(const std::string& dottedPath) : parts(splitDotted(dottedPath)) {
+            compile();
+        }
+
+        JSONPath JSONPath::fromPointer(const std::string& pointer) {
+            JSONPath path;
             try {
-                auto parts = splitPath(path);
-                return navigateToPath(jsonObj, parts);
-            } catch (...) {
-                return nullptr;
+                json::json_pointer parsed(pointer);
+                while (!parsed.empty()) {
+                    path.parts.insert(path.parts.begin(), parsed.back());
+                    parsed.pop_back();
+                }
+            } catch (const json::exception& e) {
+                throw JSONException("Invalid JSON pointer '" + pointer + "': " + e.what());
+            }
+            path.compile();
+            return path;
+        }
+
+        void JSONPath::compile() {
+            indices.clear();
+            compiled = json::json_pointer();
+            for (const std::string& part : parts) {
+                indices.push_back(parseIndex(part));
+                compiled /= part;
             }
         }
 
+        const json* JSONPath::find(const json& root) const {
+            const json* node = &root;
+            for (size_t i = 0; i < parts.size() && node; ++i) {
+                node = step(*node, parts[i], indices[i]);
+            }
+            return node;
+        }
+
+        std::vector<std::string> JSONHelper::splitPath(const std::string& path) {
+            return splitDotted(path);
+        }
+
+        const json* JSONHelper::navigateToPath(const json& jsonObj, const std::vector<std::string>& pathParts) {
+            const json* node = &jsonObj;
+            for (size_t i = 0; i < pathParts.size() && node; ++i) {
+                node = step(*node, pathParts[i], parseIndex(pathParts[i]));
+            }
+            return node;
+        }
+
+        const json* JSONHelper::findNested(const json& jsonObj, const std::string& path) {
+            return navigateToPath(jsonObj, splitPath(path));
+        }
+
+        json JSONHelper::getNestedValue(const json& jsonObj, const std::string& path) {
+            const json* node = findNested(jsonObj, path);
+            return node ? *node : json(nullptr);
+        }
+
         bool JSONHelper::hasKey(const json& jsonObj, const std::string& key) {
             return jsonObj.contains(key);
         }
 
         bool JSONHelper::hasNestedKey(const json& jsonObj, const std::string& path) {
-            return !getNestedValue(jsonObj, path).is_null();
+            const json* node = findNested(jsonObj, path);
+            return node && !node->is_null();
         }
 
         void JSONHelper::validateRequiredFields(const json& jsonObj, const std::vector<std::string>& requiredFields) {
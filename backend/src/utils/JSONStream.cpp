@@ -0,0 +1,499 @@
+#include "utils/JSONStream.h"
+#include "utils/JSONHelper.h"
+#include "utils/Logger.h"
+#include "utils/MappedFile.h"
+#include "utils/Metrics.h"
+#include "utils/ThreadPool.h"
+#include "utils/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iterator>
+
+namespace Crypto {
+    namespace Utils {
+
+        using json = nlohmann::json;
+
+        namespace {
+            struct StreamMetrics {
+                Counter& records = Metrics::counter("crypto_json_stream_records_total", "Records delivered by the streaming JSON reader");
+                Counter& bytes = Metrics::counter("crypto_json_stream_bytes_total", "JSON text bytes read by the streaming reader");
+                Counter& errors = Metrics::counter("crypto_json_errors_total", "JSON operations that failed", "operation=\"stream\"");
+                Histogram& duration = Metrics::histogram("crypto_json_parse_duration_seconds", "JSON parse latency", "source=\"stream\"");
+                Counter& ingestedLines = Metrics::counter("crypto_json_ingest_lines_total", "JSON lines read by bulk ingest");
+                Counter& ingestErrors = Metrics::counter("crypto_json_errors_total", "JSON operations that failed", "operation=\"ingest\"");
+                Gauge& ingestRate = Metrics::gauge("crypto_json_ingest_lines_per_second", "Throughput of the last completed bulk ingest");
+            };
+
+            StreamMetrics& metrics() {
+                static StreamMetrics instance;
+                return instance;
+            }
+
+            // SAX consumer: tracks the position along `recordPath` outside records and
+            // builds a DOM only inside them
+            class RecordExtractor {
+            public:
+                using number_integer_t = json::number_integer_t;
+                using number_unsigned_t = json::number_unsigned_t;
+                using number_float_t = json::number_float_t;
+                using string_t = json::string_t;
+                using binary_t = json::binary_t;
+
+                RecordExtractor(const std::string& recordPath, const JSONStream::RecordHandler& handler,
+                                const JSONStreamOptions& options)
+                    : segments(JSONPath(recordPath).segments()), handler(handler), options(options) {
+                    for (const std::string& segment : segments) {
+                        indices.push_back(segmentIndex(segment));
+                    }
+                }
+
+                size_t recordCount() const { return delivered; }
+                bool stoppedEarly() const { return stopped; }
+
+                bool null() { return scalar(nullptr); }
+                bool boolean(bool value) { return scalar(value); }
+                bool number_integer(number_integer_t value) { return scalar(value); }
+                bool number_unsigned(number_unsigned_t value) { return scalar(value); }
+                bool number_float(number_float_t value, const string_t&) { return scalar(value); }
+                bool string(string_t& value) { return scalar(std::move(value)); }
+                bool binary(binary_t& value) { return scalar(json::binary(std::move(value))); }
+
+                bool start_object(std::size_t) { return open(false); }
+                bool start_array(std::size_t) { return open(true); }
+                bool end_object() { return close(); }
+                bool end_array() { return close(); }
+
+                bool key(string_t& name) {
+                    if (skipping) {
+                        return true;
+                    }
+                    if (!building) {
+                        frames.back().key = std::move(name);
+                        return true;
+                    }
+                    if (std::find(options.skipKeys.begin(), options.skipKeys.end(), name) != options.skipKeys.end()) {
+                        // Drop the member's value; depth 0 means "the next value"
+                        skipping = true;
+                        skipDepth = 0;
+                        return true;
+                    }
+                    slot = &(*stack.back())[std::move(name)];
+                    return true;
+                }
+
+                bool parse_error(std::size_t position, const std::string&, const json::exception& e) {
+                    throw JSONException("Failed to stream JSON at byte " + std::to_string(position) + ": " + e.what());
+                }
+
+            private:
+                static constexpr size_t ANY = static_cast<size_t>(-1);
+                static constexpr size_t NOT_AN_INDEX = static_cast<size_t>(-2);
+
+                enum class Placement { SKIP, DESCEND, RECORDS, RECORD };
+
+                // Container on the path to the records, outside any record
+                struct Frame {
+                    Frame(bool array, bool records) : array(array), records(records) {}
+
+                    bool array;
+                    bool records;          // its elements are records
+                    size_t index = 0;      // next element, for arrays
+                    std::string key;       // current member, for objects
+                };
+
+                static size_t segmentIndex(const std::string& segment) {
+                    if (segment == "*") {
+                        return ANY;
+                    }
+                    if (segment.empty() || segment.size() > 18 ||
+                        !std::all_of(segment.begin(), segment.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                        return NOT_AN_INDEX;
+                    }
+                    return static_cast<size_t>(std::stoull(segment));
+                }
+
+                // Where a value that starts now, outside any record, belongs
+                Placement place(bool container, bool array) {
+                    if (!frames.empty()) {
+                        Frame& parent = frames.back();
+                        size_t position = parent.index++;
+                        if (parent.records) {
+                            return Placement::RECORD;
+                        }
+                        size_t depth = frames.size() - 1;
+                        bool matches = indices[depth] == ANY ||
+                                       (parent.array ? indices[depth] == position : parent.key == segments[depth]);
+                        if (!matches) {
+                            return Placement::SKIP;
+                        }
+                    }
+                    if (frames.size() == segments.size()) {
+                        return array ? Placement::RECORDS : Placement::SKIP;
+                    }
+                    return container ? Placement::DESCEND : Placement::SKIP;
+                }
+
+                // Stores a value inside the record being built and returns its address
+                json* insert(json&& value) {
+                    if (options.maxRecordValues != 0 && ++recordValues > options.maxRecordValues) {
+                        throw JSONException("Record " + std::to_string(delivered) + " exceeds " +
+                                            std::to_string(options.maxRecordValues) + " values");
+                    }
+                    json* parent = stack.back();
+                    if (parent->is_array()) {
+                        parent->push_back(std::move(value));
+                        return &parent->back();
+                    }
+                    *slot = std::move(value);
+                    return slot;
+                }
+
+                bool scalar(json&& value) {
+                    if (skipping) {
+                        skipping = skipDepth != 0;
+                        return true;
+                    }
+                    if (building) {
+                        insert(std::move(value));
+                        return true;
+                    }
+                    if (place(false, false) == Placement::RECORD) {
+                        record = std::move(value);
+                        return deliver();
+                    }
+                    return true;
+                }
+
+                bool open(bool array) {
+                    if (skipping) {
+                        ++skipDepth;
+                        return true;
+                    }
+                    json container = array ? json::array() : json::object();
+                    if (building) {
+                        stack.push_back(insert(std::move(container)));
+                        return true;
+                    }
+                    switch (place(true, array)) {
+                    case Placement::RECORD:
+                        building = true;
+                        recordValues = 0;
+                        record = std::move(container);
+                        stack.push_back(&record);
+                        break;
+                    case Placement::RECORDS:
+                        frames.emplace_back(true, true);
+                        break;
+                    case Placement::DESCEND:
+                        frames.emplace_back(array, false);
+                        break;
+                    case Placement::SKIP:
+                        skipping = true;
+                        skipDepth = 1;
+                        break;
+                    }
+                    return true;
+                }
+
+                bool close() {
+                    if (skipping) {
+                        skipping = --skipDepth != 0;
+                        return true;
+                    }
+                    if (building) {
+                        stack.pop_back();
+                        return stack.empty() ? deliver() : true;
+                    }
+                    frames.pop_back();
+                    return true;
+                }
+
+                bool deliver() {
+                    building = false;
+                    bool proceed = handler(record, delivered++);
+                    record = json();
+                    stopped = !proceed;
+                    return proceed;
+                }
+
+                std::vector<std::string> segments;
+                std::vector<size_t> indices;          // per segment: element index, ANY or NOT_AN_INDEX
+                const JSONStream::RecordHandler& handler;
+                const JSONStreamOptions& options;
+
+                std::vector<Frame> frames;
+                bool skipping = false;
+                size_t skipDepth = 0;                 // containers open inside the skipped value
+
+                bool building = false;
+                json record;
+                std::vector<json*> stack;             // open containers of `record`
+                json* slot = nullptr;                 // member named by the last key
+                size_t recordValues = 0;
+                size_t delivered = 0;
+                bool stopped = false;
+            };
+
+            // Byte cursor over a mapping that gives back pages the parser has moved past
+            class DiscardingCursor {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = char;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const char*;
+                using reference = const char&;
+
+                DiscardingCursor(const MappedFile& file, const char* position, size_t interval)
+                    : file(&file), position(position), released(file.begin()),
+                      checkpoint(interval ? file.begin() + std::min(interval, file.size()) : file.end()),
+                      interval(interval) {}
+
+                reference operator*() const { return *position; }
+
+                DiscardingCursor& operator++() {
+                    if (++position == checkpoint) {
+                        file->discard(static_cast<size_t>(released - file->begin()), static_cast<size_t>(position - released));
+                        released = position;
+                        checkpoint = position + std::min(interval, static_cast<size_t>(file->end() - position));
+                    }
+                    return *this;
+                }
+
+                DiscardingCursor operator++(int) {
+                    DiscardingCursor previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                bool operator==(const DiscardingCursor& other) const { return position == other.position; }
+                bool operator!=(const DiscardingCursor& other) const { return position != other.position; }
+
+            private:
+                const MappedFile* file;
+                const char* position;
+                const char* released;
+                const char* checkpoint;
+                size_t interval;
+            };
+
+            MappedFile mapInput(const std::string& filePath) {
+                try {
+                    return MappedFile(filePath);
+                } catch (const std::exception& e) {
+                    metrics().errors.increment();
+                    throw JSONException("Error streaming JSON from file: " + std::string(e.what()));
+                }
+            }
+
+            template <typename Iterator>
+            size_t extract(Iterator first, Iterator last, size_t bytes, const std::string& recordPath,
+                           const JSONStream::RecordHandler& handler, const JSONStreamOptions& options) {
+                StreamMetrics& counters = metrics();
+                counters.bytes.add(bytes);
+                RecordExtractor extractor(recordPath, handler, options);
+                try {
+                    ScopedTimer timer(counters.duration);
+                    CRYPTO_TRACE_SCOPE("streamJSON", "bytes", static_cast<int64_t>(bytes));
+                    json::sax_parse(first, last, &extractor);
+                } catch (const JSONException& e) {
+                    counters.errors.increment();
+                    counters.records.add(extractor.recordCount());
+                    LOG_ERROR(e.what());
+                    throw;
+                }
+                counters.records.add(extractor.recordCount());
+                return extractor.recordCount();
+            }
+        }
+
+        namespace {
+            // Invalid lines logged when the caller supplies no error handler
+            constexpr size_t LOGGED_LINE_ERRORS = 10;
+
+            struct ParsedLine {
+                size_t line;            // 0-based, relative to the chunk
+                json value;
+            };
+
+            struct LineError {
+                size_t line;
+                std::string message;
+            };
+
+            struct ParsedChunk {
+                std::vector<ParsedLine> records;
+                std::vector<LineError> errors;
+                size_t lines = 0;       // including blank lines, for numbering
+                size_t nonBlank = 0;
+            };
+
+            bool isBlank(char c) {
+                return c == ' ' || c == '\t' || c == '\r';
+            }
+
+            ParsedChunk parseChunk(const char* begin, const char* end, const std::vector<std::string>& requiredFields) {
+                ParsedChunk chunk;
+                const char* line = begin;
+                while (line < end) {
+                    const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+                    const char* first = line;
+                    const char* last = newline ? newline : end;
+                    while (first < last && isBlank(*first)) ++first;
+                    while (last > first && isBlank(last[-1])) --last;
+
+                    if (first < last) {
+                        ++chunk.nonBlank;
+                        // The non-throwing parse keeps the common path free of exceptions; failures are re-parsed for the message
+                        json value = json::parse(first, last, nullptr, false);
+                        if (value.is_discarded()) {
+                            std::string message = "malformed JSON";
+                            try {
+                                json reparsed = json::parse(first, last);
+                                static_cast<void>(reparsed);
+                            } catch (const json::exception& e) {
+                                message = e.what();
+                            }
+                            chunk.errors.push_back({chunk.lines, std::move(message)});
+                        } else if (!value.is_object()) {
+                            chunk.errors.push_back({chunk.lines, "expected a JSON object, got " + std::string(value.type_name())});
+                        } else {
+                            try {
+                                JSONHelper::validateRequiredFields(value, requiredFields);
+                                chunk.records.push_back({chunk.lines, std::move(value)});
+                            } catch (const JSONException& e) {
+                                chunk.errors.push_back({chunk.lines, e.what()});
+                            }
+                        }
+                    }
+
+                    ++chunk.lines;
+                    if (!newline) {
+                        break;
+                    }
+                    line = newline + 1;
+                }
+                return chunk;
+            }
+
+            JSONLinesStats ingest(const char* data, size_t size, const MappedFile* file, const JSONStream::LineHandler& handler,
+                                  const JSONLinesOptions& options, const JSONStream::LineErrorHandler& onError) {
+                StreamMetrics& counters = metrics();
+                CRYPTO_TRACE_SCOPE("ingestJSONLines", "bytes", static_cast<int64_t>(size));
+                auto started = std::chrono::steady_clock::now();
+
+                size_t threads = options.threads ? options.threads : ThreadPool::configuredThreadCount();
+                size_t window = options.maxChunksInFlight ? options.maxChunksInFlight : 4 * threads;
+                size_t chunkBytes = std::max<size_t>(options.chunkBytes, 1);
+                ThreadPool pool(threads);
+
+                const char* const end = data + size;
+                const char* cursor = data;
+                std::deque<std::future<ParsedChunk>> inFlight;    // oldest first: delivery order
+                std::deque<std::pair<const char*, const char*>> spans;
+
+                auto submitNext = [&]() {
+                    if (cursor == end) {
+                        return;
+                    }
+                    const char* begin = cursor;
+                    const char* stop = begin + std::min(chunkBytes, static_cast<size_t>(end - begin));
+                    if (stop < end) {
+                        const void* newline = std::memchr(stop, '\n', static_cast<size_t>(end - stop));
+                        stop = newline ? static_cast<const char*>(newline) + 1 : end;
+                    }
+                    cursor = stop;
+                    spans.emplace_back(begin, stop);
+                    inFlight.push_back(pool.submit([begin, stop, &options]() {
+                        return parseChunk(begin, stop, options.requiredFields);
+                    }));
+                };
+
+                while (inFlight.size() < window && cursor != end) {
+                    submitNext();
+                }
+
+                JSONLinesStats stats;
+                stats.bytes = size;
+                size_t lineBase = 0;
+                bool proceed = true;
+                while (proceed && !inFlight.empty()) {
+                    ParsedChunk chunk = inFlight.front().get();
+                    inFlight.pop_front();
+                    std::pair<const char*, const char*> span = spans.front();
+                    spans.pop_front();
+                    // Refill before delivering so the workers parse ahead while the handler runs
+                    submitNext();
+
+                    stats.lines += chunk.nonBlank;
+                    counters.ingestedLines.add(chunk.nonBlank);
+                    auto error = chunk.errors.begin();
+                    auto record = chunk.records.begin();
+                    while (proceed && (error != chunk.errors.end() || record != chunk.records.end())) {
+                        if (error != chunk.errors.end() && (record == chunk.records.end() || error->line < record->line)) {
+                            size_t lineNumber = lineBase + error->line + 1;
+                            ++stats.invalid;
+                            counters.ingestErrors.increment();
+                            if (options.stopOnError) {
+                                throw JSONException("Line " + std::to_string(lineNumber) + ": " + error->message);
+                            }
+                            if (onError) {
+                                onError(lineNumber, error->message);
+                            } else if (stats.invalid <= LOGGED_LINE_ERRORS) {
+                                LOG_WARNING("Skipping JSON line ", lineNumber, ": ", error->message);
+                            }
+                            ++error;
+                        } else {
+                            ++stats.records;
+                            proceed = handler(record->value, lineBase + record->line + 1);
+                            ++record;
+                        }
+                    }
+                    lineBase += chunk.lines;
+
+                    if (file) {
+                        file->discard(static_cast<size_t>(span.first - data), static_cast<size_t>(span.second - span.first));
+                    }
+                }
+
+                stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+                counters.ingestRate.set(static_cast<int64_t>(stats.linesPerSecond()));
+                LOG_INFO("Ingested ", stats.lines, " JSON lines (", stats.invalid, " invalid) in ", stats.seconds,
+                         " s, ", static_cast<uint64_t>(stats.linesPerSecond()), " lines/s");
+                return stats;
+            }
+        }
+
+        size_t JSONStream::forEachRecord(const std::string& filePath, const std::string& recordPath,
+                                         const RecordHandler& handler, const JSONStreamOptions& options) {
+            MappedFile file = mapInput(filePath);
+            if (file.size() == 0) {
+                return forEachRecord(file.begin(), 0, recordPath, handler, options);
+            }
+            return extract(DiscardingCursor(file, file.begin(), options.discardInterval),
+                           DiscardingCursor(file, file.end(), options.discardInterval),
+                           file.size(), recordPath, handler, options);
+        }
+
+        size_t JSONStream::forEachRecord(const char* data, size_t size, const std::string& recordPath,
+                                         const RecordHandler& handler, const JSONStreamOptions& options) {
+            return extract(data, data + size, size, recordPath, handler, options);
+        }
+
+        JSONLinesStats JSONStream::ingestLines(const std::string& filePath, const LineHandler& handler,
+                                               const JSONLinesOptions& options, const LineErrorHandler& onError) {
+            MappedFile file = mapInput(filePath);
+            return ingest(file.begin(), file.size(), &file, handler, options, onError);
+        }
+
+        JSONLinesStats JSONStream::ingestLines(const char* data, size_t size, const LineHandler& handler,
+                                               const JSONLinesOptions& options, const LineErrorHandler& onError) {
+            return ingest(data, size, nullptr, handler, options, onError);
+        }
+
+    } // namespace Utils
+} // namespace Crypto
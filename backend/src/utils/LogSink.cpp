@@ -0,0 +1,272 @@
+#include "utils/LogSink.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <zlib.h>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Crypto {
+    namespace Utils {
+
+        void ConsoleSink::write(const char* data, size_t length) {
+            std::cout.write(data, static_cast<std::streamsize>(length));
+        }
+
+        void ConsoleSink::flush() {
+            std::cout.flush();
+        }
+
+        FileSink::FileSink(const std::string& filePath) : file(std::fopen(filePath.c_str(), "ab")) {
+            if (!file) {
+                throw std::runtime_error("Failed to open log file: " + filePath);
+            }
+        }
+
+        FileSink::~FileSink() {
+            std::fclose(file);
+        }
+
+        void FileSink::write(const char* data, size_t length) {
+            std::fwrite(data, 1, length, file);
+        }
+
+        void FileSink::flush() {
+            std::fflush(file);
+        }
+
+        namespace {
+            namespace fs = std::filesystem;
+
+            const char* const TEMP_SUFFIX = ".tmp";
+            const char* const GZIP_SUFFIX = ".gz";
+            constexpr size_t COPY_BUFFER_SIZE = 64 * 1024;
+
+            bool endsWith(const std::string& text, const std::string& suffix) {
+                return text.size() >= suffix.size() &&
+                       text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+            }
+
+            fs::path directoryOf(const std::string& filePath) {
+                fs::path parent = fs::path(filePath).parent_path();
+                return parent.empty() ? fs::path(".") : parent;
+            }
+
+            // Rotated segments of `filePath` ("<name>.<stamp>.<sequence>[.gz]"), oldest first
+            std::vector<fs::path> rotatedSegments(const std::string& filePath) {
+                std::vector<fs::path> segments;
+                std::string prefix = fs::path(filePath).filename().string() + ".";
+                std::error_code ec;
+                for (fs::directory_iterator it(directoryOf(filePath), ec), end; !ec && it != end; it.increment(ec)) {
+                    std::string name = it->path().filename().string();
+                    bool stamped = name.size() > prefix.size() && std::isdigit(static_cast<unsigned char>(name[prefix.size()]));
+                    if (stamped && name.compare(0, prefix.size(), prefix) == 0 && it->is_regular_file(ec)) {
+                        segments.push_back(it->path());
+                    }
+                }
+                std::sort(segments.begin(), segments.end());
+                return segments;
+            }
+
+            // Drops the calling thread to the lowest CPU priority; compression must never compete with writers
+            void lowerThreadPriority() {
+#if defined(__linux__)
+                setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+            }
+        }
+
+        RotatingFileSink::RotatingFileSink(const std::string& filePath, RotationPolicy policy)
+            : filePath(filePath), policy(policy) {
+            openSegment();
+            std::error_code ec;
+            segmentBytes = static_cast<size_t>(fs::file_size(filePath, ec));
+            if (ec) {
+                segmentBytes = 0;
+            }
+
+            // Segments a previous run rotated but never finished compressing
+            for (const fs::path& segment : rotatedSegments(filePath)) {
+                std::string name = segment.string();
+                if (endsWith(name, TEMP_SUFFIX)) {
+                    fs::remove(segment, ec);
+                } else if (policy.compress && !endsWith(name, GZIP_SUFFIX)) {
+                    pending.push_back(name);
+                }
+            }
+            compressor = std::thread(&RotatingFileSink::compressLoop, this);
+        }
+
+        RotatingFileSink::~RotatingFileSink() {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                stopping = true;
+            }
+            queueReady.notify_one();
+            compressor.join();
+            std::fclose(file);
+        }
+
+        void RotatingFileSink::openSegment() {
+            file = std::fopen(filePath.c_str(), "ab");
+            if (!file) {
+                throw std::runtime_error("Failed to open log file: " + filePath);
+            }
+            segmentBytes = 0;
+            segmentOpened = std::chrono::steady_clock::now();
+        }
+
+        void RotatingFileSink::write(const char* data, size_t length) {
+            if (segmentBytes > 0) {
+                bool full = policy.maxBytes > 0 && segmentBytes + length > policy.maxBytes;
+                bool expired = policy.maxAge.count() > 0 &&
+                               std::chrono::steady_clock::now() - segmentOpened >= policy.maxAge;
+                if (full || expired) {
+                    rotate();
+                }
+            }
+            std::fwrite(data, 1, length, file);
+            segmentBytes += length;
+        }
+
+        void RotatingFileSink::flush() {
+            std::fflush(file);
+        }
+
+        void RotatingFileSink::rotate() {
+            std::time_t now = std::time(nullptr);
+            std::tm local;
+            localtime_r(&now, &local);
+            char stamp[32];
+            std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+
+            // The sequence keeps names unique (and ordered) within one second and across restarts
+            std::string segmentPath;
+            std::error_code ec;
+            do {
+                char sequence[16];
+                std::snprintf(sequence, sizeof(sequence), ".%06llu", static_cast<unsigned long long>(rotationCount++ % 1000000));
+                segmentPath = filePath + "." + stamp + sequence;
+            } while (fs::exists(segmentPath, ec) || fs::exists(segmentPath + GZIP_SUFFIX, ec));
+
+            // The open FILE* follows the renamed inode, so the old segment stays
+            // writable until its successor has been opened
+            std::string failure;
+            std::FILE* next = nullptr;
+            fs::rename(filePath, segmentPath, ec);
+            if (ec) {
+                failure = "cannot rename to " + segmentPath + ": " + ec.message();
+            } else if (!(next = std::fopen(filePath.c_str(), "ab"))) {
+                failure = "cannot open a new file: " + std::string(std::strerror(errno));
+                fs::rename(segmentPath, filePath, ec);
+            }
+            segmentBytes = 0;
+            segmentOpened = std::chrono::steady_clock::now();
+
+            if (!next) {
+                // Keep appending to the current segment rather than losing output;
+                // the next attempt comes after another full segment
+                if (!rotationFailed) {
+                    rotationFailed = true;
+                    std::cerr << "Log rotation of " << filePath << " failed (" << failure
+                              << "); still writing to the current segment" << std::endl;
+                }
+                return;
+            }
+            rotationFailed = false;
+            std::fclose(file);
+            file = next;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                pending.push_back(segmentPath);
+            }
+            queueReady.notify_one();
+        }
+
+        void RotatingFileSink::compressLoop() {
+            lowerThreadPriority();
+            std::unique_lock<std::mutex> lock(queueMutex);
+            while (true) {
+                queueReady.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (pending.empty()) {
+                    return;
+                }
+                std::string segmentPath = std::move(pending.front());
+                pending.pop_front();
+                lock.unlock();
+                if (policy.compress) {
+                    compressSegment(segmentPath);
+                }
+                pruneSegments();
+                lock.lock();
+            }
+        }
+
+        void RotatingFileSink::compressSegment(const std::string& segmentPath) {
+            std::string target = segmentPath + GZIP_SUFFIX;
+            std::string temp = target + TEMP_SUFFIX;
+
+            std::FILE* input = std::fopen(segmentPath.c_str(), "rb");
+            if (!input) {
+                return;
+            }
+            std::string mode = "wb" + std::to_string(std::min(std::max(policy.compressionLevel, 1), 9));
+            gzFile output = gzopen(temp.c_str(), mode.c_str());
+            if (!output) {
+                std::fclose(input);
+                std::cerr << "Failed to create " << temp << std::endl;
+                return;
+            }
+
+            std::vector<char> buffer(COPY_BUFFER_SIZE);
+            bool ok = true;
+            size_t count;
+            while (ok && (count = std::fread(buffer.data(), 1, buffer.size(), input)) > 0) {
+                ok = gzwrite(output, buffer.data(), static_cast<unsigned>(count)) == static_cast<int>(count);
+            }
+            ok = ok && !std::ferror(input);
+            std::fclose(input);
+            ok = gzclose(output) == Z_OK && ok;
+
+            // The plain segment is only removed once the compressed copy is complete
+            std::error_code ec;
+            if (ok) {
+                fs::rename(temp, target, ec);
+                ok = !ec;
+            }
+            if (ok) {
+                fs::remove(segmentPath, ec);
+            } else {
+                fs::remove(temp, ec);
+                std::cerr << "Failed to compress log segment " << segmentPath << std::endl;
+            }
+        }
+
+        void RotatingFileSink::pruneSegments() {
+            if (policy.maxSegments == 0) {
+                return;
+            }
+            std::vector<fs::path> segments = rotatedSegments(filePath);
+            segments.erase(std::remove_if(segments.begin(), segments.end(),
+                                          [](const fs::path& segment) { return endsWith(segment.string(), TEMP_SUFFIX); }),
+                           segments.end());
+            std::error_code ec;
+            for (size_t i = 0; i + policy.maxSegments < segments.size(); ++i) {
+                fs::remove(segments[i], ec);
+            }
+        }
+
+    } // namespace Utils
+} // namespace Crypto
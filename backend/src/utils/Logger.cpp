@@ -1,76 +1,482 @@
     #include "utils/Logger.h"
+    #include "utils/Config.h"
+    #include <algorithm>
+    #include <cstdlib>
     #include <memory>
+    #include <cctype>
     #include <chrono>
-    #include <iomanip>
-    #include <sstream>
+    #include <condition_variable>
+    #include <ctime>
     #include <iostream>
+    #include <thread>
 
     namespace Crypto {
         namespace Utils {
 
-            std::unique_ptr<Logger> Logger::instance = nullptr;
+            std::atomic<Logger*> Logger::current{nullptr};
             std::mutex Logger::mutex_;
 
-            std::string Logger::logLevelToString(LogLevel level) {
-                switch (level) {
-                    case LogLevel::DEBUG: return "DEBUG";
-                    case LogLevel::INFO: return "INFO";
-                    case LogLevel::WARNING: return "WARNING";
-                    case LogLevel::ERROR: return "ERROR";
-                    case LogLevel::CRITICAL: return "CRITICAL";
-                    default: return "UNKNOWN";
+            namespace {
+                struct Entry {
+                    LogLevel level = LogLevel::INFO;
+                    std::chrono::system_clock::time_point time;
+                    std::string message;
+                };
+
+                // Bounded MPSC ring (sequence-numbered slots): producers claim a slot with one
+                // CAS on the enqueue cursor, the single consumer needs no atomics RMW at all
+                class LogQueue {
+                public:
+                    explicit LogQueue(size_t capacity) {
+                        size_t size = 2;
+                        while (size < capacity) {
+                            size <<= 1;
+                        }
+                        slots.reset(new Slot[size]);
+                        mask = size - 1;
+                        for (size_t i = 0; i < size; ++i) {
+                            slots[i].sequence.store(i, std::memory_order_relaxed);
+                        }
+                    }
+
+                    bool tryPush(Entry& entry) {
+                        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+                        for (;;) {
+                            Slot& slot = slots[position & mask];
+                            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                            if (difference == 0) {
+                                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                                    slot.entry = std::move(entry);
+                                    slot.sequence.store(position + 1, std::memory_order_release);
+                                    return true;
+                                }
+                            } else if (difference < 0) {
+                                return false;    // full: the consumer has not released this slot yet
+                            } else {
+                                position = enqueuePosition.load(std::memory_order_relaxed);
+                            }
+                        }
+                    }
+
+                    // Slots claimed so far, including ones a producer is still filling
+                    size_t claimed() const { return enqueuePosition.load(std::memory_order_acquire); }
+
+                    bool ready() const {
+                        return slots[dequeuePosition & mask].sequence.load(std::memory_order_acquire) == dequeuePosition + 1;
+                    }
+
+                    bool tryPop(Entry& entry) {
+                        Slot& slot = slots[dequeuePosition & mask];
+                        if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+                            return false;
+                        }
+                        entry = std::move(slot.entry);
+                        slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+                        ++dequeuePosition;
+                        return true;
+                    }
+
+                private:
+                    struct Slot {
+                        std::atomic<size_t> sequence{0};
+                        Entry entry;
+                    };
+
+                    std::unique_ptr<Slot[]> slots;
+                    size_t mask = 0;
+                    alignas(64) std::atomic<size_t> enqueuePosition{0};
+                    alignas(64) size_t dequeuePosition = 0;
+                };
+
+                const char* levelName(LogLevel level) {
+                    switch (level) {
+                        case LogLevel::DEBUG: return "DEBUG";
+                        case LogLevel::INFO: return "INFO";
+                        case LogLevel::WARNING: return "WARNING";
+                        case LogLevel::ERROR: return "ERROR";
+                        case LogLevel::CRITICAL: return "CRITICAL";
+                        default: return "UNKNOWN";
+                    }
+                }
+
+                // "YYYY-mm-dd HH:MM:SS", re-rendered only when the second changes
+                class TimestampCache {
+                public:
+                    const char* format(std::chrono::system_clock::time_point time) {
+                        std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+                        if (seconds != cachedSecond) {
+                            std::tm local;
+                            localtime_r(&seconds, &local);
+                            std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+                            cachedSecond = seconds;
+                        }
+                        return text;
+                    }
+
+                private:
+                    std::time_t cachedSecond = -1;
+                    char text[32] = {};
+                };
+
+                void appendLine(std::string& out, const char* stamp, LogLevel level, const std::string& message) {
+                    out += stamp;
+                    out += " [";
+                    out += levelName(level);
+                    out += "] ";
+                    out += message;
+                    out += '\n';
                 }
+
+                const size_t WRITE_BATCH = 256;
+                const auto IDLE_WAIT = std::chrono::milliseconds(50);
+            }
+
+            struct Logger::AsyncState {
+                AsyncState(size_t capacity, LogOverflowPolicy policy) : queue(capacity), capacity(capacity), policy(policy) {}
+
+                LogQueue queue;
+                size_t capacity;            // as requested; the ring rounds it up
+                LogOverflowPolicy policy;
+                std::atomic<bool> running{true};
+                std::atomic<uint64_t> dropped{0};
+                std::atomic<uint64_t> written{0};
+
+                // The sink thread parks here only when idle; producers notify only if it is parked
+                std::mutex wakeMutex;
+                std::condition_variable wake;
+                std::condition_variable drained;
+                std::atomic<bool> sleeping{false};
+                std::thread thread;
+
+                void notify() {
+                    if (sleeping.load(std::memory_order_acquire)) {
+                        std::lock_guard<std::mutex> lock(wakeMutex);
+                        wake.notify_one();
+                    }
+                }
+            };
+
+            std::string Logger::logLevelToString(LogLevel level) {
+                return levelName(level);
             }
 
             std::string Logger::getCurrentTime() {
-                auto now = std::chrono::system_clock::now();
-                std::time_t now_time = std::chrono::system_clock::to_time_t(now);
-                std::tm* tm = std::localtime(&now_time);
-                std::ostringstream oss;
-                oss << std::put_time(tm, "%Y-%m-%d %H:%M:%S");
-                return oss.str();   
+                return TimestampCache().format(std::chrono::system_clock::now());
             }
 
             Logger::Logger() {
+                sinks.push_back(std::make_shared<ConsoleSink>());
                 std::cout << "[Logger initialized]" << std::endl;
             }
 
             Logger* Logger::getInstance() {
+                Logger* logger = current.load(std::memory_order_acquire);
+                if (logger) {
+                    return logger;
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                logger = current.load(std::memory_order_relaxed);
+                if (!logger) {
+                    // Never deleted: objects destroyed after this one may still log
+                    logger = new Logger();
+                    current.store(logger, std::memory_order_release);
+                    std::atexit([]() { current.load(std::memory_order_acquire)->shutdown(); });
+                }
+                return logger;
+            }
+
+            void Logger::log(LogLevel level, std::string message) {
+                if (!isEnabled(level)) {
+                    return;
+                }
+
+                AsyncState* state = activeAsync.load(std::memory_order_acquire);
+                if (!state) {
+                    writeSync(level, message);
+                    return;
+                }
+
+                Entry entry{level, std::chrono::system_clock::now(), std::move(message)};
+                while (!state->queue.tryPush(entry)) {
+                    if (state->policy == LogOverflowPolicy::DROP) {
+                        state->dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    if (!state->running.load(std::memory_order_acquire)) {
+                        writeSync(entry.level, entry.message);
+                        return;
+                    }
+                    state->notify();
+                    std::this_thread::yield();
+                }
+                state->notify();
+            }
+
+            void Logger::writeSync(LogLevel level, const std::string& message) {
+                std::string line;
+                line.reserve(message.size() + 40);
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                appendLine(line, getCurrentTime().c_str(), level, message);
+                for (const auto& sink : sinks) {
+                    sink->write(line.data(), line.size());
+                    sink->flush();
+                }
+            }
+
+            void Logger::sinkLoop(AsyncState* state) {
+                TimestampCache stamps;
+                std::string batch;
+                Entry entry;
+                uint64_t reportedDrops = 0;
+                bool dirty = false;
+
+                for (;;) {
+                    size_t count = 0;
+                    batch.clear();
+                    while (count < WRITE_BATCH && state->queue.tryPop(entry)) {
+                        appendLine(batch, stamps.format(entry.time), entry.level, entry.message);
+                        ++count;
+                    }
+
+                    uint64_t drops = state->dropped.load(std::memory_order_relaxed);
+                    if (drops != reportedDrops) {
+                        appendLine(batch, stamps.format(std::chrono::system_clock::now()), LogLevel::WARNING,
+                                   "Logger queue full, dropped " + std::to_string(drops - reportedDrops) + " message(s)");
+                        reportedDrops = drops;
+                    }
+
+                    if (!batch.empty()) {
+                        std::lock_guard<std::mutex> lock(sinkMutex);
+                        for (const auto& sink : sinks) {
+                            sink->write(batch.data(), batch.size());
+                        }
+                        dirty = true;
+                    }
+                    if (count) {
+                        state->written.fetch_add(count, std::memory_order_release);
+                        state->drained.notify_all();
+                        continue;
+                    }
+
+                    // Queue is dry: flush once per burst, then park
+                    if (dirty) {
+                        std::lock_guard<std::mutex> lock(sinkMutex);
+                        for (const auto& sink : sinks) {
+                            sink->flush();
+                        }
+                        dirty = false;
+                    }
+
+                    std::unique_lock<std::mutex> lock(state->wakeMutex);
+                    state->drained.notify_all();
+                    if (!state->running.load(std::memory_order_acquire) &&
+                        state->written.load(std::memory_order_acquire) == state->queue.claimed()) {
+                        return;
+                    }
+                    state->sleeping.store(true, std::memory_order_seq_cst);
+                    // Re-check after advertising: a producer that saw `sleeping == false` has already published
+                    // or will be picked up by the bounded wait
+                    if (!state->queue.ready()) {
+                        state->wake.wait_for(lock, IDLE_WAIT);
+                    }
+                    state->sleeping.store(false, std::memory_order_release);
+                }
+            }
+
+            void Logger::addSink(std::shared_ptr<LogSink> sink) {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                sinks.push_back(std::move(sink));
+            }
+
+            void Logger::removeSink(const std::shared_ptr<LogSink>& sink) {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                sinks.erase(std::remove(sinks.begin(), sinks.end(), sink), sinks.end());
+            }
+
+            void Logger::clearSinks() {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                sinks.clear();
+            }
+
+            void Logger::startAsync(size_t queueCapacity, LogOverflowPolicy policy) {
                 std::lock_guard<std::mutex> lock(mutex_);
-                if (!instance)
-                    instance = std::unique_ptr<Logger>(new Logger());
-                return instance.get();
+                AsyncState* running = activeAsync.load(std::memory_order_acquire);
+                if (running) {
+                    if (running->capacity == queueCapacity && running->policy == policy) {
+                        return;
+                    }
+                    // New parameters need a new ring: drain the old one first
+                    stopAsyncLocked();
+                }
+                // A stopped state may still be referenced by a producer that raced with stopAsync()
+                if (async) {
+                    retired.push_back(std::move(async));
+                }
+                async.reset(new AsyncState(queueCapacity, policy));
+                AsyncState* state = async.get();
+                state->thread = std::thread([this, state]() { sinkLoop(state); });
+                activeAsync.store(state, std::memory_order_release);
             }
 
-            void Logger::log(LogLevel level, const std::string& message) {
+            void Logger::stopAsync() {
                 std::lock_guard<std::mutex> lock(mutex_);
-                std::string logMessage = getCurrentTime() + " [" + logLevelToString(level) + "] " + message;
+                stopAsyncLocked();
+            }
 
-                // OUTPUT TO CONSOLE
-                if (level >= LogLevel::DEBUG)
-                    std::cout << logMessage << std::endl;
+            void Logger::stopAsyncLocked() {
+                AsyncState* state = activeAsync.exchange(nullptr, std::memory_order_acq_rel);
+                if (!state) {
+                    return;
+                }
+                state->running.store(false, std::memory_order_release);
+                {
+                    std::lock_guard<std::mutex> wakeLock(state->wakeMutex);
+                    state->wake.notify_one();
+                }
+                state->thread.join();
+                // Producers that loaded the state just before the swap may have published since; drain them here
+                state->running.store(false, std::memory_order_release);
+                sinkLoop(state);
             }
 
+            uint64_t Logger::droppedCount() const {
+                const AsyncState* state = async.get();
+                return state ? state->dropped.load(std::memory_order_relaxed) : 0;
+            }
 
-            void Logger::debug(const std::string& message) {
-                log(LogLevel::DEBUG, message);
+            void Logger::flush() {
+                if (BinaryLog::isOpen()) {
+                    BinaryLog::flush();
+                }
+                AsyncState* state = activeAsync.load(std::memory_order_acquire);
+                if (state) {
+                    uint64_t target = state->queue.claimed();
+                    std::unique_lock<std::mutex> lock(state->wakeMutex);
+                    state->wake.notify_one();
+                    while (state->written.load(std::memory_order_acquire) < target &&
+                           state->running.load(std::memory_order_acquire)) {
+                        state->drained.wait_for(lock, IDLE_WAIT);
+                    }
+                }
+                // Written entries may still sit in sink buffers until the sink thread's next idle flush
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                for (const auto& sink : sinks) {
+                    sink->flush();
+                }
             }
-            void Logger::info(const std::string& message) {
-                log(LogLevel::INFO, message);
+
+            bool Logger::parseLevel(const std::string& name, LogLevel& level) {
+                std::string lower;
+                for (char c : name) {
+                    lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                }
+                for (LogLevel candidate : {LogLevel::DEBUG, LogLevel::INFO, LogLevel::WARNING, LogLevel::ERROR, LogLevel::CRITICAL}) {
+                    std::string candidateName = levelName(candidate);
+                    for (char& c : candidateName) {
+                        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                    }
+                    if (lower == candidateName) {
+                        level = candidate;
+                        return true;
+                    }
+                }
+                return false;
             }
-            void Logger::warning(const std::string& message) {
-                log(LogLevel::WARNING, message);
+
+            void Logger::startBinary(const std::string& filePath) {
+                BinaryLog::open(filePath);
             }
-            void Logger::error(const std::string& message) {    
-                log(LogLevel::ERROR, message);
-            }   
-            void Logger::critical(const std::string& message) {
-                log(LogLevel::CRITICAL, message);
-            }   
-            
-            // DESTRUCTOR
-            Logger::~Logger() {
-                std::cout << "[Logger destroyed]" << std::endl;
+
+            void Logger::stopBinary() {
+                BinaryLog::close();
+            }
+
+            void Logger::configure() {
+                json settings = Config::getValueByKey("logging");
+                if (!settings.is_object()) {
+                    return;
+                }
+                std::string levelSetting = settings.value("level", std::string());
+                LogLevel configuredLevel;
+                if (parseLevel(levelSetting, configuredLevel)) {
+                    setLevel(configuredLevel);
+                } else if (!levelSetting.empty()) {
+                    warning("Unknown logging.level '" + levelSetting + "', keeping " + levelName(level()));
+                }
+                if (settings.value("async", false)) {
+                    int capacity = settings.value("queueCapacity", static_cast<int>(DEFAULT_QUEUE_CAPACITY));
+                    std::string policy = settings.value("overflowPolicy", std::string("block"));
+                    startAsync(capacity > 0 ? static_cast<size_t>(capacity) : DEFAULT_QUEUE_CAPACITY,
+                               policy == "drop" ? LogOverflowPolicy::DROP : LogOverflowPolicy::BLOCK);
+                } else {
+                    stopAsync();
+                }
+
+                std::string binaryPath = settings.value("binaryPath", std::string());
+                if (!binaryPath.empty()) {
+                    try {
+                        startBinary(binaryPath);
+                    } catch (const std::exception& e) {
+                        error(std::string("Binary log unavailable: ") + e.what());
+                    }
+                }
+
+                // The previous file sink goes first so two compressors never work on the same segments
+                json fileSettings = settings.value("file", json::object());
+                if (fileSink) {
+                    flush();
+                    removeSink(fileSink);
+                    fileSink.reset();
+                }
+                std::string filePath = fileSettings.is_object() ? fileSettings.value("path", std::string()) : std::string();
+                if (!filePath.empty()) {
+                    RotationPolicy policy;
+                    policy.maxBytes = fileSettings.value("maxBytes", policy.maxBytes);
+                    policy.maxAge = std::chrono::seconds(fileSettings.value("maxAgeSeconds", static_cast<int64_t>(policy.maxAge.count())));
+                    policy.maxSegments = fileSettings.value("maxSegments", policy.maxSegments);
+                    policy.compress = fileSettings.value("compress", policy.compress);
+                    policy.compressionLevel = fileSettings.value("compressionLevel", policy.compressionLevel);
+                    try {
+                        fileSink = std::make_shared<RotatingFileSink>(filePath, policy);
+                        addSink(fileSink);
+                    } catch (const std::exception& e) {
+                        error(std::string("Log file unavailable: ") + e.what());
+                    }
+                }
+            }
+
+
+            void Logger::debug(std::string message) {
+                log(LogLevel::DEBUG, std::move(message));
+            }
+            void Logger::info(std::string message) {
+                log(LogLevel::INFO, std::move(message));
+            }
+            void Logger::warning(std::string message) {
+                log(LogLevel::WARNING, std::move(message));
+            }
+            void Logger::error(std::string message) {
+                log(LogLevel::ERROR, std::move(message));
+            }
+            void Logger::critical(std::string message) {
+                log(LogLevel::CRITICAL, std::move(message));
+            }
+
+            // SHUTDOWN (DRAINS THE ASYNC QUEUE BEFORE REPORTING)
+            void Logger::shutdown() {
+                BinaryLog::close();
+                stopAsync();
+                flush();
+                bool report;
+                {
+                    std::lock_guard<std::mutex> lock(sinkMutex);
+                    report = !shutDown;
+                    shutDown = true;
+                }
+                if (report) {
+                    std::cout << "[Logger shut down]" << std::endl;
+                }
             }
 
 
@@ -0,0 +1,127 @@
+#include "utils/MappedFile.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Crypto {
+    namespace Utils {
+
+        namespace {
+            // Owns the descriptor only for the duration of a mapping call
+            struct FileDescriptor {
+                int fd;
+                explicit FileDescriptor(const std::string& filePath) : fd(::open(filePath.c_str(), O_RDONLY | O_CLOEXEC)) {
+                    if (fd < 0) {
+                        std::string errorMsg = "Cannot open file: " + filePath + " (" + std::strerror(errno) + ")";
+                        LOG_ERROR(errorMsg);
+                        throw std::runtime_error(errorMsg);
+                    }
+                }
+                ~FileDescriptor() { ::close(fd); }
+
+                size_t size(const std::string& filePath) const {
+                    struct stat info;
+                    if (::fstat(fd, &info) != 0) {
+                        std::string errorMsg = "Cannot stat file: " + filePath + " (" + std::strerror(errno) + ")";
+                        LOG_ERROR(errorMsg);
+                        throw std::runtime_error(errorMsg);
+                    }
+                    return static_cast<size_t>(info.st_size);
+                }
+            };
+
+            uint8_t* mapRange(int fd, size_t length, off_t offset, const std::string& filePath) {
+                void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, offset);
+                if (address == MAP_FAILED) {
+                    std::string errorMsg = "Cannot map file: " + filePath + " (" + std::strerror(errno) + ")";
+                    LOG_ERROR(errorMsg);
+                    throw std::runtime_error(errorMsg);
+                }
+                // Advisory only: failure just means the kernel keeps its default readahead
+                ::madvise(address, length, MADV_SEQUENTIAL);
+                return static_cast<uint8_t*>(address);
+            }
+        }
+
+        MappedFile::MappedFile(const std::string& filePath) {
+            FileDescriptor file(filePath);
+            length = file.size(filePath);
+            if (length > 0) {
+                mapping = mapRange(file.fd, length, 0, filePath);
+            }
+        }
+
+        MappedFile::~MappedFile() {
+            release();
+        }
+
+        MappedFile::MappedFile(MappedFile&& other) noexcept
+            : mapping(other.mapping), length(other.length) {
+            other.mapping = nullptr;
+            other.length = 0;
+        }
+
+        MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                release();
+                mapping = other.mapping;
+                length = other.length;
+                other.mapping = nullptr;
+                other.length = 0;
+            }
+            return *this;
+        }
+
+        void MappedFile::release() {
+            if (mapping) {
+                ::munmap(mapping, length);
+                mapping = nullptr;
+                length = 0;
+            }
+        }
+
+        void MappedFile::discard(size_t offset, size_t count) const {
+            if (!mapping || offset >= length) {
+                return;
+            }
+            size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            size_t first = (offset + pageSize - 1) / pageSize * pageSize;
+            size_t last = std::min(length, offset + count) / pageSize * pageSize;
+            if (first < last) {
+                // Advisory only, like the readahead hint
+                ::madvise(mapping + first, last - first, MADV_DONTNEED);
+            }
+        }
+
+        void MappedFile::forEachChunk(const std::string& filePath, size_t chunkSize,
+                                      const std::function<void(const uint8_t*, size_t)>& consumer) {
+            FileDescriptor file(filePath);
+            size_t total = file.size(filePath);
+
+            // Window offsets must be page aligned
+            size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            chunkSize = std::max(pageSize, chunkSize - chunkSize % pageSize);
+
+            for (size_t offset = 0; offset < total; offset += chunkSize) {
+                size_t windowLength = std::min(chunkSize, total - offset);
+                uint8_t* window = mapRange(file.fd, windowLength, static_cast<off_t>(offset), filePath);
+                try {
+                    consumer(window, windowLength);
+                } catch (...) {
+                    ::munmap(window, windowLength);
+                    throw;
+                }
+                ::munmap(window, windowLength);
+            }
+        }
+
+    } // namespace Utils
+} // namespace Crypto
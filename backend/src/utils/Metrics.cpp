@@ -0,0 +1,534 @@
+#include "utils/Metrics.h"
+#include "utils/Config.h"
+#include "utils/JSONHelper.h"
+#include "utils/Logger.h"
+
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Crypto {
+    namespace Utils {
+
+        namespace {
+            using MetricsDetail::CELLS_PER_SLOT;
+            using MetricsDetail::MAX_THREAD_SLOTS;
+            using MetricsDetail::ThreadCells;
+
+            enum class Kind { COUNTER, GAUGE, HISTOGRAM };
+
+            struct Entry {
+                Kind kind;
+                std::string name;
+                std::string labels;
+                std::unique_ptr<Counter> counter;
+                std::unique_ptr<Gauge> gauge;
+                std::unique_ptr<Histogram> histogram;
+            };
+
+            struct Family {
+                Kind kind;
+                std::string help;
+                std::vector<Entry*> entries;
+            };
+
+            struct ExportState {
+                std::mutex mutex;    // serializes startExport() / stopExport()
+                std::thread worker;
+                int wakePipe[2] = {-1, -1};
+                int listenFd = -1;
+                MetricsExportOptions options;
+            };
+
+            // Never destroyed: thread-exit hooks and the exporter may run after static destructors
+            struct Registry {
+                std::mutex mutex;
+                std::vector<std::unique_ptr<Entry>> entries;
+                std::unordered_map<std::string, Entry*> byKey;
+                std::map<std::string, Family> families;    // sorted, so exports are stable
+                size_t nextOffset = 0;
+
+                // Index MAX_THREAD_SLOTS is the shared overflow slot
+                ThreadCells slots[MAX_THREAD_SLOTS + 1];
+                std::atomic<std::atomic<uint64_t>*> published[MAX_THREAD_SLOTS + 1];
+                std::atomic<bool> claimed[MAX_THREAD_SLOTS];
+
+                ExportState exporter;
+
+                Registry() {
+                    for (size_t i = 0; i <= MAX_THREAD_SLOTS; ++i) {
+                        published[i].store(nullptr, std::memory_order_relaxed);
+                    }
+                    for (size_t i = 0; i < MAX_THREAD_SLOTS; ++i) {
+                        claimed[i].store(false, std::memory_order_relaxed);
+                    }
+                    slots[MAX_THREAD_SLOTS].cells = allocateCells();
+                    slots[MAX_THREAD_SLOTS].exclusive = false;
+                    published[MAX_THREAD_SLOTS].store(slots[MAX_THREAD_SLOTS].cells, std::memory_order_release);
+                }
+
+                // calloc leaves the pages untouched until a metric actually lands on them
+                static std::atomic<uint64_t>* allocateCells() {
+                    void* memory = std::calloc(CELLS_PER_SLOT, sizeof(std::atomic<uint64_t>));
+                    if (!memory) {
+                        throw std::bad_alloc();
+                    }
+                    return static_cast<std::atomic<uint64_t>*>(memory);
+                }
+            };
+
+            Registry& registry() {
+                static Registry* instance = new Registry();
+                return *instance;
+            }
+
+            struct SlotHolder {
+                size_t slot = MAX_THREAD_SLOTS;
+
+                ~SlotHolder() {
+                    if (slot == MAX_THREAD_SLOTS) {
+                        return;
+                    }
+                    Registry& reg = registry();
+                    // Anything recorded later in this thread's teardown goes to the shared slot
+                    MetricsDetail::localCells = &reg.slots[MAX_THREAD_SLOTS];
+                    reg.claimed[slot].store(false, std::memory_order_release);
+                }
+            };
+
+            thread_local SlotHolder holder;
+
+            std::string metricKey(const std::string& name, const std::string& labels) {
+                return labels.empty() ? name : name + "{" + labels + "}";
+            }
+
+            std::string withLabel(const std::string& labels, const std::string& extra) {
+                return "{" + (labels.empty() ? extra : labels + "," + extra) + "}";
+            }
+
+            std::string formatNumber(double value) {
+                char text[32];
+                std::snprintf(text, sizeof(text), "%.9g", value);
+                return text;
+            }
+
+            constexpr double SECONDS_PER_NANOSECOND = 1e-9;
+            const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+            // `create` builds the metric object at the given cell offset (it runs inside Metrics, which may construct them)
+            template <typename Create>
+            Entry& registerMetric(Kind kind, const std::string& name, const std::string& help, const std::string& labels,
+                                  Create create) {
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+
+                auto family = reg.families.find(name);
+                if (family != reg.families.end() && family->second.kind != kind) {
+                    throw std::runtime_error("Metric " + name + " is already registered with another type");
+                }
+                std::string key = metricKey(name, labels);
+                auto existing = reg.byKey.find(key);
+                if (existing != reg.byKey.end()) {
+                    return *existing->second;
+                }
+
+                size_t cells = kind == Kind::COUNTER ? 1 : kind == Kind::HISTOGRAM ? Histogram::CELLS : 0;
+                if (reg.nextOffset + cells > CELLS_PER_SLOT) {
+                    throw std::runtime_error("Metric cell space exhausted registering " + key);
+                }
+
+                std::unique_ptr<Entry> entry(new Entry());
+                entry->kind = kind;
+                entry->name = name;
+                entry->labels = labels;
+                create(*entry, reg.nextOffset);
+                reg.nextOffset += cells;
+
+                Entry* raw = entry.get();
+                reg.entries.push_back(std::move(entry));
+                reg.byKey[key] = raw;
+                if (family == reg.families.end()) {
+                    family = reg.families.emplace(name, Family{kind, help, {}}).first;
+                }
+                family->second.entries.push_back(raw);
+                return *raw;
+            }
+
+            // Stable copy of the family table; metrics themselves are never removed
+            std::map<std::string, Family> families() {
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                return reg.families;
+            }
+        }
+
+        namespace MetricsDetail {
+            ThreadCells* claimCells() {
+                Registry& reg = registry();
+                for (size_t i = 0; i < MAX_THREAD_SLOTS; ++i) {
+                    if (reg.claimed[i].load(std::memory_order_relaxed) ||
+                        reg.claimed[i].exchange(true, std::memory_order_acquire)) {
+                        continue;
+                    }
+                    if (!reg.slots[i].cells) {
+                        reg.slots[i].cells = Registry::allocateCells();
+                        reg.slots[i].exclusive = true;
+                        reg.published[i].store(reg.slots[i].cells, std::memory_order_release);
+                    }
+                    holder.slot = i;
+                    localCells = &reg.slots[i];
+                    return localCells;
+                }
+                localCells = &reg.slots[MAX_THREAD_SLOTS];
+                return localCells;
+            }
+
+            uint64_t merge(size_t offset) {
+                Registry& reg = registry();
+                uint64_t total = 0;
+                for (size_t i = 0; i <= MAX_THREAD_SLOTS; ++i) {
+                    std::atomic<uint64_t>* cells = reg.published[i].load(std::memory_order_acquire);
+                    if (cells) {
+                        total += cells[offset].load(std::memory_order_relaxed);
+                    }
+                }
+                return total;
+            }
+
+            uint64_t mergeMax(size_t offset) {
+                Registry& reg = registry();
+                uint64_t largest = 0;
+                for (size_t i = 0; i <= MAX_THREAD_SLOTS; ++i) {
+                    std::atomic<uint64_t>* cells = reg.published[i].load(std::memory_order_acquire);
+                    if (cells) {
+                        uint64_t value = cells[offset].load(std::memory_order_relaxed);
+                        largest = value > largest ? value : largest;
+                    }
+                }
+                return largest;
+            }
+        }
+
+        uint64_t HistogramSnapshot::quantile(double q) const {
+            if (count == 0) {
+                return 0;
+            }
+            q = q < 0.0 ? 0.0 : q > 1.0 ? 1.0 : q;
+            uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)));
+            rank = rank == 0 ? 1 : rank;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < buckets.size(); ++i) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    // Bucket midpoint, never above the largest value actually recorded
+                    uint64_t value = Histogram::bucketLowerBound(i) + Histogram::bucketWidth(i) / 2;
+                    return value < max ? value : max;
+                }
+            }
+            return max;
+        }
+
+        HistogramSnapshot Histogram::snapshot() const {
+            HistogramSnapshot result;
+            result.buckets.resize(BUCKETS);
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                result.buckets[i] = MetricsDetail::merge(offset + i);
+                result.count += result.buckets[i];
+            }
+            result.sum = MetricsDetail::merge(offset + BUCKETS);
+            result.max = MetricsDetail::mergeMax(offset + BUCKETS + 1);
+            return result;
+        }
+
+        Counter& Metrics::counter(const std::string& name, const std::string& help, const std::string& labels) {
+            return *registerMetric(Kind::COUNTER, name, help, labels,
+                                   [](Entry& entry, size_t offset) { entry.counter.reset(new Counter(offset)); }).counter;
+        }
+
+        Gauge& Metrics::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+            return *registerMetric(Kind::GAUGE, name, help, labels,
+                                   [](Entry& entry, size_t) { entry.gauge.reset(new Gauge()); }).gauge;
+        }
+
+        Histogram& Metrics::histogram(const std::string& name, const std::string& help, const std::string& labels) {
+            return *registerMetric(Kind::HISTOGRAM, name, help, labels,
+                                   [](Entry& entry, size_t offset) { entry.histogram.reset(new Histogram(offset)); }).histogram;
+        }
+
+        Metrics::json Metrics::snapshot() {
+            json counters = json::object();
+            json gauges = json::object();
+            json histograms = json::object();
+            for (const auto& family : families()) {
+                for (const Entry* entry : family.second.entries) {
+                    std::string key = metricKey(entry->name, entry->labels);
+                    switch (entry->kind) {
+                        case Kind::COUNTER:
+                            counters[key] = entry->counter->value();
+                            break;
+                        case Kind::GAUGE:
+                            gauges[key] = entry->gauge->value();
+                            break;
+                        case Kind::HISTOGRAM: {
+                            HistogramSnapshot merged = entry->histogram->snapshot();
+                            histograms[key] = {
+                                {"count", merged.count},
+                                {"sum", merged.sum * SECONDS_PER_NANOSECOND},
+                                {"mean", merged.mean() * SECONDS_PER_NANOSECOND},
+                                {"p50", merged.quantile(0.5) * SECONDS_PER_NANOSECOND},
+                                {"p90", merged.quantile(0.9) * SECONDS_PER_NANOSECOND},
+                                {"p99", merged.quantile(0.99) * SECONDS_PER_NANOSECOND},
+                                {"p999", merged.quantile(0.999) * SECONDS_PER_NANOSECOND},
+                                {"max", merged.max * SECONDS_PER_NANOSECOND}
+                            };
+                            break;
+                        }
+                    }
+                }
+            }
+            return {{"counters", counters}, {"gauges", gauges}, {"histograms", histograms}};
+        }
+
+        Metrics::json Metrics::snapshotResponse() {
+            return JSONHelper::createSuccessResponse(snapshot(), "Metrics snapshot");
+        }
+
+        std::string Metrics::prometheusText() {
+            std::string out;
+            for (const auto& family : families()) {
+                const std::string& name = family.first;
+                const Family& info = family.second;
+                const char* type = info.kind == Kind::COUNTER ? "counter" : info.kind == Kind::GAUGE ? "gauge" : "summary";
+                out += "# HELP " + name + " " + info.help + "\n";
+                out += "# TYPE " + name + " " + type + "\n";
+                for (const Entry* entry : info.entries) {
+                    std::string labels = entry->labels.empty() ? "" : "{" + entry->labels + "}";
+                    switch (entry->kind) {
+                        case Kind::COUNTER:
+                            out += name + labels + " " + std::to_string(entry->counter->value()) + "\n";
+                            break;
+                        case Kind::GAUGE:
+                            out += name + labels + " " + std::to_string(entry->gauge->value()) + "\n";
+                            break;
+                        case Kind::HISTOGRAM: {
+                            HistogramSnapshot merged = entry->histogram->snapshot();
+                            for (double q : QUANTILES) {
+                                out += name + withLabel(entry->labels, "quantile=\"" + formatNumber(q) + "\"") + " " +
+                                       formatNumber(merged.quantile(q) * SECONDS_PER_NANOSECOND) + "\n";
+                            }
+                            out += name + "_sum" + labels + " " + formatNumber(merged.sum * SECONDS_PER_NANOSECOND) + "\n";
+                            out += name + "_count" + labels + " " + std::to_string(merged.count) + "\n";
+                            break;
+                        }
+                    }
+                }
+            }
+            return out;
+        }
+
+        void Metrics::writePrometheusFile(const std::string& filePath) {
+            std::string temp = filePath + ".tmp";
+            {
+                std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) {
+                    throw std::runtime_error("Cannot open metrics file for writing: " + temp);
+                }
+                file << prometheusText();
+                if (!file) {
+                    throw std::runtime_error("Failed writing metrics file: " + temp);
+                }
+            }
+            // Scrapers never see a half-written file
+            if (std::rename(temp.c_str(), filePath.c_str()) != 0) {
+                throw std::runtime_error("Cannot replace metrics file: " + filePath);
+            }
+        }
+
+        namespace {
+            void sendAll(int fd, const std::string& data) {
+                size_t sent = 0;
+                while (sent < data.size()) {
+                    ssize_t written = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                    if (written <= 0) {
+                        return;
+                    }
+                    sent += static_cast<size_t>(written);
+                }
+            }
+
+            // One request per connection: GET /metrics (Prometheus text) or GET /metrics.json
+            void serveClient(int fd) {
+                timeval timeout{1, 0};
+                setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+                std::string request;
+                char buffer[1024];
+                while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+                    ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+                    if (received <= 0) {
+                        break;
+                    }
+                    request.append(buffer, static_cast<size_t>(received));
+                }
+
+                std::string status = "200 OK";
+                std::string contentType;
+                std::string body;
+                if (request.compare(0, 13, "GET /metrics ") == 0) {
+                    contentType = "text/plain; version=0.0.4";
+                    body = Metrics::prometheusText();
+                } else if (request.compare(0, 18, "GET /metrics.json ") == 0) {
+                    contentType = "application/json";
+                    body = JSONHelper::toCompactString(Metrics::snapshotResponse());
+                } else {
+                    status = "404 Not Found";
+                    contentType = "text/plain";
+                    body = "not found\n";
+                }
+                sendAll(fd, "HTTP/1.0 " + status + "\r\nContent-Type: " + contentType +
+                            "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+            }
+
+            void exportLoop(ExportState* state) {
+                static Counter& exportErrors =
+                    Metrics::counter("crypto_metrics_export_errors_total", "Failed metrics file writes");
+                const MetricsExportOptions& options = state->options;
+                auto nextWrite = std::chrono::steady_clock::now();
+
+                while (true) {
+                    int timeoutMs = -1;
+                    if (!options.prometheusFile.empty()) {
+                        auto now = std::chrono::steady_clock::now();
+                        if (now >= nextWrite) {
+                            try {
+                                Metrics::writePrometheusFile(options.prometheusFile);
+                            } catch (const std::exception&) {
+                                exportErrors.increment();
+                            }
+                            nextWrite = now + options.interval;
+                        }
+                        timeoutMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                            nextWrite - std::chrono::steady_clock::now()).count()) + 1;
+                        timeoutMs = timeoutMs < 0 ? 0 : timeoutMs;
+                    }
+
+                    pollfd fds[2] = {{state->wakePipe[0], POLLIN, 0}, {state->listenFd, POLLIN, 0}};
+                    int ready = ::poll(fds, state->listenFd >= 0 ? 2 : 1, timeoutMs);
+                    if (ready < 0 && errno != EINTR) {
+                        return;
+                    }
+                    if (fds[0].revents) {
+                        return;
+                    }
+                    if (state->listenFd >= 0 && (fds[1].revents & POLLIN)) {
+                        int client = ::accept(state->listenFd, nullptr, nullptr);
+                        if (client >= 0) {
+                            serveClient(client);
+                            ::close(client);
+                        }
+                    }
+                }
+            }
+
+            int openEndpoint(uint16_t port) {
+                int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                if (fd < 0) {
+                    throw std::runtime_error("Cannot create metrics socket");
+                }
+                int reuse = 1;
+                setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+                sockaddr_in address{};
+                address.sin_family = AF_INET;
+                address.sin_port = htons(port);
+                address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, 16) != 0) {
+                    ::close(fd);
+                    throw std::runtime_error("Cannot listen for metrics on 127.0.0.1:" + std::to_string(port));
+                }
+                return fd;
+            }
+
+            // Caller holds the export mutex
+            void stopLocked(ExportState& state) {
+                if (state.worker.joinable()) {
+                    char wake = 1;
+                    ssize_t ignored = ::write(state.wakePipe[1], &wake, 1);
+                    (void)ignored;
+                    state.worker.join();
+                }
+                for (int* fd : {&state.wakePipe[0], &state.wakePipe[1], &state.listenFd}) {
+                    if (*fd >= 0) {
+                        ::close(*fd);
+                        *fd = -1;
+                    }
+                }
+            }
+        }
+
+        void Metrics::startExport(const MetricsExportOptions& options) {
+            ExportState& state = registry().exporter;
+            std::lock_guard<std::mutex> lock(state.mutex);
+            stopLocked(state);
+            if (options.prometheusFile.empty() && options.port == 0) {
+                return;
+            }
+            if (options.port != 0) {
+                state.listenFd = openEndpoint(options.port);
+            }
+            if (::pipe2(state.wakePipe, O_CLOEXEC) != 0) {
+                stopLocked(state);
+                throw std::runtime_error("Cannot create metrics exporter wake pipe");
+            }
+            state.options = options;
+            if (state.options.interval.count() <= 0) {
+                state.options.interval = std::chrono::seconds(15);
+            }
+            state.worker = std::thread(exportLoop, &state);
+        }
+
+        void Metrics::stopExport() {
+            ExportState& state = registry().exporter;
+            std::lock_guard<std::mutex> lock(state.mutex);
+            stopLocked(state);
+        }
+
+        void Metrics::configure() {
+            json settings = Config::getValueByKey("metrics");
+            if (!settings.is_object()) {
+                return;
+            }
+            MetricsExportOptions options;
+            options.prometheusFile = settings.value("prometheusFile", std::string());
+            options.interval = std::chrono::seconds(settings.value("exportIntervalSeconds", static_cast<int64_t>(options.interval.count())));
+            int port = settings.value("port", 0);
+            options.port = port > 0 && port <= 65535 ? static_cast<uint16_t>(port) : 0;
+            try {
+                startExport(options);
+                if (!options.prometheusFile.empty() || options.port != 0) {
+                    LOG_INFO("Metrics export started", options.port ? " on 127.0.0.1:" + std::to_string(options.port) : std::string(),
+                             options.prometheusFile.empty() ? std::string() : " to " + options.prometheusFile);
+                }
+            } catch (const std::exception& e) {
+                LOG_ERROR("Metrics export unavailable: ", e.what());
+            }
+        }
+
+    } // namespace Utils
+} // namespace Crypto
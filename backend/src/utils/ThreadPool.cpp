@@ -0,0 +1,173 @@
+#include "utils/ThreadPool.h"
+#include "utils/Config.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace Crypto {
+    namespace Utils {
+
+        ThreadPool::ThreadPool(size_t threadCount) {
+            resize(threadCount);
+        }
+
+        ThreadPool::~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                stopping = true;
+            }
+            queueCondition.notify_all();
+            std::lock_guard<std::mutex> lock(resizeMutex);
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        void ThreadPool::resize(size_t threadCount) {
+            std::lock_guard<std::mutex> lock(resizeMutex);
+            joinRetired();
+            size_t running = workerCount.load(std::memory_order_relaxed);
+            if (threadCount > running) {
+                size_t missing = threadCount - running;
+                {
+                    // Workers told to retire but still running are simply kept
+                    std::lock_guard<std::mutex> queueLock(queueMutex);
+                    size_t kept = std::min(retiring, missing);
+                    retiring -= kept;
+                    missing -= kept;
+                }
+                for (size_t i = 0; i < missing; ++i) {
+                    workers.emplace_back([this]() { workerLoop(); });
+                }
+            } else if (threadCount < running) {
+                {
+                    std::lock_guard<std::mutex> queueLock(queueMutex);
+                    retiring += running - threadCount;
+                }
+                queueCondition.notify_all();
+            }
+            workerCount.store(threadCount, std::memory_order_relaxed);
+        }
+
+        void ThreadPool::joinRetired() {
+            std::vector<std::thread::id> exited;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                exited.swap(retired);
+            }
+            for (std::thread::id id : exited) {
+                auto it = std::find_if(workers.begin(), workers.end(),
+                                       [id](const std::thread& worker) { return worker.get_id() == id; });
+                if (it != workers.end()) {
+                    it->join();
+                    workers.erase(it);
+                }
+            }
+        }
+
+        void ThreadPool::enqueue(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                tasks.push(std::move(task));
+            }
+            queueCondition.notify_one();
+        }
+
+        void ThreadPool::workerLoop() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    queueCondition.wait(lock, [this]() { return stopping || retiring > 0 || !tasks.empty(); });
+                    if (retiring > 0 && !stopping) {
+                        --retiring;
+                        retired.push_back(std::this_thread::get_id());
+                        return;
+                    }
+                    if (stopping && tasks.empty()) {
+                        return;
+                    }
+                    task = std::move(tasks.front());
+                    tasks.pop();
+                }
+                task();
+            }
+        }
+
+        void ThreadPool::parallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& body) {
+            if (count == 0) {
+                return;
+            }
+            minChunk = std::max<size_t>(minChunk, 1);
+            size_t chunks = std::min(size() + 1, (count + minChunk - 1) / minChunk);
+            if (chunks <= 1) {
+                body(0, count);
+                return;
+            }
+
+            size_t chunkSize = (count + chunks - 1) / chunks;
+            size_t remaining = chunks - 1;
+            std::mutex doneMutex;
+            std::condition_variable doneCondition;
+            std::exception_ptr failure;
+
+            auto runChunk = [&](size_t begin, size_t end) {
+                try {
+                    body(begin, end);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    if (!failure) failure = std::current_exception();
+                }
+            };
+
+            for (size_t chunk = 1; chunk < chunks; ++chunk) {
+                size_t begin = chunk * chunkSize;
+                size_t end = std::min(count, begin + chunkSize);
+                enqueue([&, begin, end]() {
+                    runChunk(begin, end);
+                    // Decrement under the lock so the caller cannot return while we still touch its frame
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    if (--remaining == 0) {
+                        doneCondition.notify_one();
+                    }
+                });
+            }
+
+            // The caller takes the first chunk instead of idling
+            runChunk(0, std::min(count, chunkSize));
+
+            // Help drain the queue so the call completes even if the pool shrank underneath it
+            while (runPending()) {
+            }
+
+            std::unique_lock<std::mutex> lock(doneMutex);
+            doneCondition.wait(lock, [&]() { return remaining == 0; });
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+
+        bool ThreadPool::runPending() {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (tasks.empty()) {
+                    return false;
+                }
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+            return true;
+        }
+
+        size_t ThreadPool::configuredThreadCount() {
+            int configured = Config::settings()->mining.threadCount;
+            if (configured > 0) {
+                return static_cast<size_t>(configured);
+            }
+            return std::max<unsigned>(1, std::thread::hardware_concurrency());
+        }
+
+    } // namespace Utils
+} // namespace Crypto
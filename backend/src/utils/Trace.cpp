@@ -0,0 +1,280 @@
+#include "utils/Trace.h"
+#include "utils/Config.h"
+#include "utils/JSONHelper.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRYPTO_TRACE_PAUSE() _mm_pause()
+#else
+#define CRYPTO_TRACE_PAUSE() ((void)0)
+#endif
+
+namespace Crypto {
+    namespace Utils {
+
+        std::atomic<bool> Trace::recording{false};
+
+        namespace {
+            struct ThreadBuffer {
+                std::atomic<bool> locked{false};
+                uint32_t thread = 0;
+                std::vector<TraceEvent> events;    // capacity fixed while recording
+                size_t used = 0;
+
+                void lock() {
+                    while (locked.exchange(true, std::memory_order_acquire)) {
+                        CRYPTO_TRACE_PAUSE();
+                    }
+                }
+                void unlock() { locked.store(false, std::memory_order_release); }
+            };
+
+            // Spans of a thread that has exited, trimmed to what it recorded
+            struct FinishedThread {
+                uint32_t thread;
+                std::vector<TraceEvent> events;
+            };
+
+            struct Registry {
+                std::mutex mutex;
+                std::vector<std::shared_ptr<ThreadBuffer>> buffers;    // one per live tracing thread
+                std::vector<std::shared_ptr<ThreadBuffer>> spare;      // released on thread exit, reused by new threads
+                std::vector<FinishedThread> finished;
+                std::atomic<size_t> eventsPerThread{Trace::DEFAULT_EVENTS_PER_THREAD};
+                std::atomic<uint64_t> dropped{0};
+                uint64_t origin = 0;              // steady-clock time of start(); trace timestamps count from here
+                uint32_t nextThread = 0;
+                std::string outputPath;           // set by configure()
+            };
+
+            // Never destroyed: spans can close during static destruction
+            Registry& registry() {
+                static Registry* instance = new Registry();
+                return *instance;
+            }
+
+            // Copies the exiting thread's spans out for export and hands its buffer
+            // to the next thread that traces, so short-lived pools (a new
+            // ThreadPool per JSONStream ingest, say) do not each leave one behind
+            void releaseBuffer(std::shared_ptr<ThreadBuffer> buffer) {
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                buffer->lock();
+                if (buffer->used > 0) {
+                    reg.finished.push_back({buffer->thread, std::vector<TraceEvent>(buffer->events.begin(),
+                                                                                    buffer->events.begin() + buffer->used)});
+                    buffer->used = 0;
+                }
+                buffer->unlock();
+                reg.buffers.erase(std::remove(reg.buffers.begin(), reg.buffers.end(), buffer), reg.buffers.end());
+                reg.spare.push_back(std::move(buffer));
+            }
+
+            struct LocalBuffer {
+                std::shared_ptr<ThreadBuffer> buffer;
+                ~LocalBuffer();
+            };
+
+            thread_local LocalBuffer localBuffer;
+            // Set once `localBuffer` is destroyed; spans closing after that are dropped
+            thread_local bool threadExited = false;
+
+            LocalBuffer::~LocalBuffer() {
+                threadExited = true;
+                if (buffer) {
+                    releaseBuffer(std::move(buffer));
+                }
+            }
+
+            ThreadBuffer* threadBuffer() {
+                if (threadExited) {
+                    return nullptr;
+                }
+                if (!localBuffer.buffer) {
+                    Registry& reg = registry();
+                    size_t capacity = reg.eventsPerThread.load(std::memory_order_relaxed);
+                    std::shared_ptr<ThreadBuffer> buffer;
+                    {
+                        std::lock_guard<std::mutex> lock(reg.mutex);
+                        if (!reg.spare.empty()) {
+                            buffer = std::move(reg.spare.back());
+                            reg.spare.pop_back();
+                        }
+                    }
+                    if (!buffer) {
+                        buffer = std::make_shared<ThreadBuffer>();
+                    }
+                    if (buffer->events.size() != capacity) {
+                        buffer->events.resize(capacity);
+                    }
+                    std::lock_guard<std::mutex> lock(reg.mutex);
+                    buffer->thread = reg.nextThread++;
+                    reg.buffers.push_back(buffer);
+                    localBuffer.buffer = std::move(buffer);
+                }
+                return localBuffer.buffer.get();
+            }
+
+            double microseconds(uint64_t nanos) {
+                return static_cast<double>(nanos) / 1000.0;
+            }
+        }
+
+        uint64_t Trace::now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        void Trace::record(const TraceEvent& event) {
+            ThreadBuffer* buffer = threadBuffer();
+            if (!buffer) {
+                registry().dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            buffer->lock();
+            if (buffer->used < buffer->events.size()) {
+                buffer->events[buffer->used++] = event;
+            } else {
+                registry().dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            buffer->unlock();
+        }
+
+        void Trace::start(size_t eventsPerThread) {
+            Registry& reg = registry();
+            {
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                reg.eventsPerThread.store(eventsPerThread > 0 ? eventsPerThread : DEFAULT_EVENTS_PER_THREAD,
+                                          std::memory_order_relaxed);
+                if (!recording.load(std::memory_order_relaxed)) {
+                    reg.origin = now();
+                    reg.dropped.store(0, std::memory_order_relaxed);
+                }
+            }
+            recording.store(true, std::memory_order_release);
+        }
+
+        void Trace::stop() {
+            recording.store(false, std::memory_order_release);
+        }
+
+        void Trace::clear() {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            for (const auto& buffer : reg.buffers) {
+                buffer->lock();
+                buffer->used = 0;
+                buffer->unlock();
+            }
+            reg.finished.clear();
+            reg.dropped.store(0, std::memory_order_relaxed);
+        }
+
+        uint64_t Trace::droppedCount() {
+            return registry().dropped.load(std::memory_order_relaxed);
+        }
+
+        Trace::json Trace::toJSON() {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            const int pid = static_cast<int>(::getpid());
+
+            json events = json::array();
+            auto appendThread = [&](uint32_t thread, const std::vector<TraceEvent>& spans) {
+                if (spans.empty()) {
+                    return;
+                }
+                events.push_back({
+                    {"name", "thread_name"},
+                    {"ph", "M"},
+                    {"pid", pid},
+                    {"tid", thread},
+                    {"args", {{"name", "thread " + std::to_string(thread)}}}
+                });
+                for (const TraceEvent& event : spans) {
+                    json args = json::object();
+                    for (uint8_t i = 0; i < event.argCount; ++i) {
+                        args[event.argNames[i]] = event.argValues[i];
+                    }
+                    uint64_t begin = event.begin > reg.origin ? event.begin - reg.origin : 0;
+                    events.push_back({
+                        {"name", event.name},
+                        {"cat", "crypto"},
+                        {"ph", "X"},
+                        {"ts", microseconds(begin)},
+                        {"dur", microseconds(event.end - event.begin)},
+                        {"pid", pid},
+                        {"tid", thread},
+                        {"args", args}
+                    });
+                }
+            };
+
+            for (const FinishedThread& finished : reg.finished) {
+                appendThread(finished.thread, finished.events);
+            }
+            std::vector<TraceEvent> copy;
+            for (const auto& buffer : reg.buffers) {
+                buffer->lock();
+                copy.assign(buffer->events.begin(), buffer->events.begin() + buffer->used);
+                buffer->unlock();
+                appendThread(buffer->thread, copy);
+            }
+
+            return {
+                {"traceEvents", events},
+                {"displayTimeUnit", "ns"},
+                {"otherData", {{"droppedEvents", reg.dropped.load(std::memory_order_relaxed)}}}
+            };
+        }
+
+        void Trace::dump(const std::string& filePath) {
+            JSONHelper::saveToFile(toJSON(), filePath, -1);
+        }
+
+        void Trace::configure() {
+            json settings = Config::getValueByKey("tracing");
+            if (!settings.is_object() || !settings.value("enabled", false)) {
+                return;
+            }
+            if (!CRYPTO_ENABLE_TRACING) {
+                LOG_WARNING("tracing.enabled is set but this build has CRYPTO_ENABLE_TRACING off; no spans will be recorded");
+            }
+            {
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                reg.outputPath = settings.value("outputPath", std::string());
+            }
+            int eventsPerThread = settings.value("eventsPerThread", static_cast<int>(DEFAULT_EVENTS_PER_THREAD));
+            start(eventsPerThread > 0 ? static_cast<size_t>(eventsPerThread) : DEFAULT_EVENTS_PER_THREAD);
+        }
+
+        void Trace::finish() {
+            std::string outputPath;
+            {
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                outputPath = reg.outputPath;
+            }
+            if (!isRecording() || outputPath.empty()) {
+                return;
+            }
+            stop();
+            try {
+                dump(outputPath);
+                LOG_INFO("Trace written to ", outputPath);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Trace dump failed: ", e.what());
+            }
+        }
+
+    } // namespace Utils
+} // namespace Crypto
@@ -1,35 +1,417 @@
 #include "utils/Config.h"
 #include "utils/Logger.h"
+#include "utils/Metrics.h"
+#include "utils/Trace.h"
 
+#include <cerrno>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
 
 namespace Crypto {
     namespace Utils {
 
         std::unique_ptr<Config> Config::instance = nullptr;
+        std::atomic<Config*> Config::current{nullptr};
         std::mutex Config::mutex_;
+        std::shared_ptr<const ConfigSnapshot> Config::published;
+
+        namespace {
+            // Address-only sentinel for a handle not yet resolved in a snapshot
+            const json* unresolved() {
+                static const char marker = 0;
+                return reinterpret_cast<const json*>(&marker);
+            }
+
+            // Memo slot per distinct dotted key; slots are never reused, since a
+            // live snapshot may already hold a resolution for them
+            struct KeyIds {
+                std::mutex mutex;
+                std::map<std::string, size_t> ids;
+            };
+
+            size_t keyId(const std::string& dottedKey) {
+                static KeyIds* registry = new KeyIds();
+                std::lock_guard<std::mutex> lock(registry->mutex);
+                auto it = registry->ids.find(dottedKey);
+                if (it != registry->ids.end()) {
+                    return it->second;
+                }
+                size_t id = registry->ids.size();
+                if (id >= ConfigSnapshot::MAX_KEYS) {
+                    throw ConfigException("too many distinct ConfigKey keys (limit " + std::to_string(ConfigSnapshot::MAX_KEYS) + ")");
+                }
+                registry->ids.emplace(dottedKey, id);
+                return id;
+            }
+
+            std::vector<std::string> splitKey(const std::string& key) {
+                std::vector<std::string> parts;
+                size_t start = 0;
+                while (start < key.size()) {
+                    size_t dot = key.find('.', start);
+                    if (dot == std::string::npos) {
+                        dot = key.size();
+                    }
+                    parts.emplace_back(key, start, dot - start);
+                    start = dot + 1;
+                }
+                return parts;
+            }
+
+            const json* child(const json* node, const char* name, size_t length) {
+                if (!node->is_object()) {
+                    return nullptr;
+                }
+                auto it = node->find(std::string_view(name, length));
+                return it == node->end() ? nullptr : &*it;
+            }
+
+            // Served by settings() before the first successful load
+            const std::shared_ptr<const ConfigSnapshot>& emptySnapshot() {
+                static const auto* instance = new std::shared_ptr<const ConfigSnapshot>(
+                    std::make_shared<const ConfigSnapshot>(json::object()));
+                return *instance;
+            }
+
+            const json* section(const json& document, const char* name) {
+                auto it = document.find(name);
+                if (it == document.end()) {
+                    return nullptr;
+                }
+                if (!it->is_object()) {
+                    throw ConfigException(std::string(name) + " must be an object");
+                }
+                return &*it;
+            }
+
+            void readString(const json* parent, const char* sectionName, const char* key, std::string& out) {
+                if (!parent || !parent->contains(key)) {
+                    return;
+                }
+                const json& value = (*parent)[key];
+                if (!value.is_string()) {
+                    throw ConfigException(std::string(sectionName) + "." + key + " must be a string");
+                }
+                out = value.get<std::string>();
+            }
+
+            void readInt(const json* parent, const char* sectionName, const char* key, int& out,
+                         int minimum, int maximum = std::numeric_limits<int>::max()) {
+                if (!parent || !parent->contains(key)) {
+                    return;
+                }
+                const json& value = (*parent)[key];
+                if (!value.is_number_integer()) {
+                    throw ConfigException(std::string(sectionName) + "." + key + " must be an integer");
+                }
+                int64_t number = value.get<int64_t>();
+                if (number < minimum || number > maximum) {
+                    throw ConfigException(std::string(sectionName) + "." + key + " must be in [" +
+                                          std::to_string(minimum) + ", " + std::to_string(maximum) + "]");
+                }
+                out = static_cast<int>(number);
+            }
+
+            void readBool(const json* parent, const char* sectionName, const char* key, bool& out) {
+                if (!parent || !parent->contains(key)) {
+                    return;
+                }
+                const json& value = (*parent)[key];
+                if (!value.is_boolean()) {
+                    throw ConfigException(std::string(sectionName) + "." + key + " must be a boolean");
+                }
+                out = value.get<bool>();
+            }
+
+            // Listener table and file watcher; never destroyed, like the snapshots
+            struct ReloadState {
+                std::mutex listenersMutex;
+                std::map<size_t, ConfigListener> listeners;
+                size_t nextListener = 1;
+                std::mutex notifyMutex;    // keeps publish + notify of one load ahead of the next
+
+                std::mutex watchMutex;
+                std::thread watcher;
+                int wakePipe[2] = {-1, -1};
+                int inotifyFd = -1;
+            };
+
+            ReloadState& reloadState() {
+                static ReloadState* instance = new ReloadState();
+                return *instance;
+            }
+
+            // Editors often write several events per save (truncate, write, rename); wait for quiet
+            constexpr int RELOAD_DEBOUNCE_MS = 100;
+
+            void watchLoop(ReloadState* state, std::string filePath, std::string fileName) {
+                alignas(inotify_event) char buffer[4096];
+                bool pending = false;
+                while (true) {
+                    pollfd fds[2] = {{state->wakePipe[0], POLLIN, 0}, {state->inotifyFd, POLLIN, 0}};
+                    int ready = ::poll(fds, 2, pending ? RELOAD_DEBOUNCE_MS : -1);
+                    if (ready < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        return;
+                    }
+                    if (fds[0].revents) {
+                        return;
+                    }
+                    if (ready == 0) {
+                        pending = false;
+                        LOG_INFO("Config file changed, reloading ", filePath);
+                        Config::loadConfig(filePath);
+                        continue;
+                    }
+                    ssize_t length = ::read(state->inotifyFd, buffer, sizeof(buffer));
+                    for (ssize_t offset = 0; offset < length;) {
+                        const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                        if (event->len > 0 && fileName == event->name) {
+                            pending = true;
+                        }
+                        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                    }
+                }
+            }
+
+            // Caller holds `watchMutex`
+            void stopWatchingLocked(ReloadState& state) {
+                if (state.watcher.joinable()) {
+                    char wake = 1;
+                    ssize_t ignored = ::write(state.wakePipe[1], &wake, 1);
+                    (void)ignored;
+                    state.watcher.join();
+                }
+                for (int* fd : {&state.wakePipe[0], &state.wakePipe[1], &state.inotifyFd}) {
+                    if (*fd >= 0) {
+                        ::close(*fd);
+                        *fd = -1;
+                    }
+                }
+            }
+
+            // String-keyed lookups (the legacy getters) are counted; ConfigKey and settings() are not
+            // Copies the value out, so the snapshot is held only for the call; null when absent
+            json lookup(const std::string& key) {
+                static Counter& lookups = Metrics::counter("crypto_config_lookups_total", "Config values looked up by dotted key");
+                lookups.increment();
+                std::shared_ptr<const ConfigSnapshot> snapshot = Config::settings();
+                const json* value = snapshot->find(key);
+                return value ? *value : json(nullptr);
+            }
+        }
+
+        ConfigSnapshot::ConfigSnapshot(json parsed)
+            : document(std::move(parsed)), resolved(new std::atomic<const json*>[MAX_KEYS]) {
+            for (size_t i = 0; i < MAX_KEYS; ++i) {
+                resolved[i].store(unresolved(), std::memory_order_relaxed);
+            }
+            if (!document.is_object()) {
+                throw ConfigException("top level must be an object");
+            }
+
+            const json* blockchainSection = section(document, "blockchain");
+            readString(blockchainSection, "blockchain", "networkName", blockchain.networkName);
+            readInt(blockchainSection, "blockchain", "targetBlockTime", blockchain.targetBlockTime, 1);
+            readInt(blockchainSection, "blockchain", "maxBlockSize", blockchain.maxBlockSize, 1);
+
+            const json* networkSection = section(document, "network");
+            readInt(networkSection, "network", "port", network.port, 1, 65535);
+            readString(networkSection, "network", "bindAddress", network.bindAddress);
+            readInt(networkSection, "network", "maxConnections", network.maxConnections, 0);
+
+            const json* miningSection = section(document, "mining");
+            readBool(miningSection, "mining", "enableMining", mining.enableMining);
+            readInt(miningSection, "mining", "threadCount", mining.threadCount, 0);
+        }
+
+        const json* ConfigSnapshot::find(const std::vector<std::string>& path) const {
+            const json* node = &document;
+            for (const std::string& part : path) {
+                node = child(node, part.data(), part.size());
+                if (!node) {
+                    return nullptr;
+                }
+            }
+            return node;
+        }
+
+        const json* ConfigSnapshot::find(const std::string& dottedKey) const {
+            const json* node = &document;
+            size_t start = 0;
+            while (start < dottedKey.size()) {
+                size_t dot = dottedKey.find('.', start);
+                if (dot == std::string::npos) {
+                    dot = dottedKey.size();
+                }
+                node = child(node, dottedKey.data() + start, dot - start);
+                if (!node) {
+                    return nullptr;
+                }
+                start = dot + 1;
+            }
+            return node;
+        }
+
+        const json* ConfigSnapshot::resolve(size_t id, const std::vector<std::string>& path) const {
+            const json* node = resolved[id].load(std::memory_order_acquire);
+            if (node == unresolved()) {
+                // Racing resolvers compute the same pointer, so a plain store is enough
+                node = find(path);
+                resolved[id].store(node, std::memory_order_release);
+            }
+            return node;
+        }
+
+        ConfigKey::ConfigKey(const std::string& dottedKey)
+            : dottedKey(dottedKey), path(splitKey(dottedKey)), id(keyId(dottedKey)) {
+        }
+
+        std::shared_ptr<const json> ConfigKey::find() const {
+            std::shared_ptr<const ConfigSnapshot> snapshot = Config::settings();
+            const json* node = snapshot->resolve(id, path);
+            if (!node) {
+                return nullptr;
+            }
+            // Aliasing constructor: points at the node, owns the snapshot
+            return std::shared_ptr<const json>(std::move(snapshot), node);
+        }
+
+        std::string ConfigKey::getString(const std::string& fallback) const {
+            std::shared_ptr<const json> value = find();
+            return value && value->is_string() ? value->get<std::string>() : fallback;
+        }
+
+        int ConfigKey::getInt(int fallback) const {
+            std::shared_ptr<const json> value = find();
+            return value && value->is_number_integer() ? value->get<int>() : fallback;
+        }
+
+        bool ConfigKey::getBool(bool fallback) const {
+            std::shared_ptr<const json> value = find();
+            return value && value->is_boolean() ? value->get<bool>() : fallback;
+        }
 
         Config::Config() {
             Logger::getInstance()->log(LogLevel::INFO, "Config initialized.");
         }
 
         Config::~Config() {
-            Logger::getInstance()->log(LogLevel::INFO, "Config destroyed.");
+            stopWatching();
+            current.store(nullptr, std::memory_order_release);
         }
 
         Config* Config::getInstance() {
+            Config* config = current.load(std::memory_order_acquire);
+            if (config) {
+                return config;
+            }
             std::lock_guard<std::mutex> lock(mutex_);
             if (!instance) {
                 instance = std::unique_ptr<Config>(new Config());
+                current.store(instance.get(), std::memory_order_release);
             }
             return instance.get();
         }
 
+        void Config::publish(std::shared_ptr<const ConfigSnapshot> snapshot) {
+            getInstance();
+            ReloadState& state = reloadState();
+            std::lock_guard<std::mutex> notifyLock(state.notifyMutex);
+
+            // Owning handles keep both snapshots alive while the listeners run
+            std::shared_ptr<const ConfigSnapshot> previous = settings();
+            std::shared_ptr<const ConfigSnapshot> next = snapshot;
+            std::atomic_store(&published, std::move(snapshot));
+
+            // Listeners run after the swap, so readers are never held up by them
+            std::vector<ConfigListener> listeners;
+            {
+                std::lock_guard<std::mutex> lock(state.listenersMutex);
+                for (const auto& entry : state.listeners) {
+                    listeners.push_back(entry.second);
+                }
+            }
+            for (const ConfigListener& listener : listeners) {
+                try {
+                    listener(*previous, *next);
+                } catch (const std::exception& e) {
+                    LOG_ERROR("Config listener failed: ", e.what());
+                }
+            }
+        }
+
+        size_t Config::subscribe(ConfigListener listener) {
+            ReloadState& state = reloadState();
+            std::lock_guard<std::mutex> lock(state.listenersMutex);
+            size_t id = state.nextListener++;
+            state.listeners.emplace(id, std::move(listener));
+            return id;
+        }
+
+        void Config::unsubscribe(size_t id) {
+            ReloadState& state = reloadState();
+            std::lock_guard<std::mutex> lock(state.listenersMutex);
+            state.listeners.erase(id);
+        }
+
+        void Config::watch(const std::string& filePath) {
+            ReloadState& state = reloadState();
+            std::lock_guard<std::mutex> lock(state.watchMutex);
+            stopWatchingLocked(state);
+
+            // The directory is watched, not the file, so replacing it by rename is seen too
+            std::string directory = ".";
+            std::string fileName = filePath;
+            size_t slash = filePath.find_last_of('/');
+            if (slash != std::string::npos) {
+                directory = slash == 0 ? "/" : filePath.substr(0, slash);
+                fileName = filePath.substr(slash + 1);
+            }
+
+            state.inotifyFd = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+            if (state.inotifyFd < 0 ||
+                ::inotify_add_watch(state.inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0 ||
+                ::pipe2(state.wakePipe, O_CLOEXEC) != 0) {
+                stopWatchingLocked(state);
+                throw std::runtime_error("Cannot watch config directory " + directory);
+            }
+            state.watcher = std::thread(watchLoop, &state, filePath, fileName);
+            LOG_INFO("Watching ", filePath, " for changes");
+        }
+
+        void Config::stopWatching() {
+            ReloadState& state = reloadState();
+            std::lock_guard<std::mutex> lock(state.watchMutex);
+            stopWatchingLocked(state);
+        }
+
+        std::shared_ptr<const ConfigSnapshot> Config::settings() {
+            std::shared_ptr<const ConfigSnapshot> current = std::atomic_load(&published);
+            return current ? current : emptySnapshot();
+        }
+
         bool Config::loadConfig(const std::string& filePath) {
+            static Counter& loaded = Metrics::counter("crypto_config_loads_total", "Config load attempts", "result=\"ok\"");
+            static Counter& failed = Metrics::counter("crypto_config_loads_total", "Config load attempts", "result=\"error\"");
+            static Histogram& duration = Metrics::histogram("crypto_config_load_duration_seconds", "Config file read and parse time");
+            ScopedTimer timer(duration);
+            CRYPTO_TRACE_SCOPE("loadConfig");
+
             std::ifstream file(filePath);
             if (!file.is_open()) {
+                failed.increment();
                 Logger::getInstance()->log(LogLevel::ERROR, "Failed to open config file: " + filePath);
                 return false;
             }
@@ -37,39 +419,37 @@ namespace Crypto {
             try {
                 json parsed;
                 file >> parsed;
-                getInstance()->configData = parsed;
+                publish(std::make_shared<const ConfigSnapshot>(std::move(parsed)));
+                loaded.increment();
                 Logger::getInstance()->log(LogLevel::INFO, "Config loaded from " + filePath);
                 return true;
+            } catch (const ConfigException& e) {
+                failed.increment();
+                Logger::getInstance()->log(LogLevel::ERROR, "Rejected " + filePath + ": " + e.what());
+                return false;
             } catch (const std::exception& e) {
+                failed.increment();
                 Logger::getInstance()->log(LogLevel::ERROR, std::string("Config parse error: ") + e.what());
                 return false;
             }
         }
 
         json Config::getValueByKey(const std::string& key) {
-            json* current = &getInstance()->configData;
-            std::istringstream ss(key);
-            std::string part;
-
-            while (std::getline(ss, part, '.')) {
-                if (!current->contains(part)) return nullptr;
-                current = &(*current)[part];
-            }
-            return *current;
+            return lookup(key);
         }
 
         std::string Config::getString(const std::string& key) {
-            json val = getValueByKey(key);
+            json val = lookup(key);
             return val.is_string() ? val.get<std::string>() : "";
         }
 
         int Config::getInt(const std::string& key) {
-            json val = getValueByKey(key);
+            json val = lookup(key);
             return val.is_number_integer() ? val.get<int>() : 0;
         }
 
         bool Config::getBool(const std::string& key) {
-            json val = getValueByKey(key);
+            json val = lookup(key);
             return val.is_boolean() ? val.get<bool>() : false;
         }
 
@@ -0,0 +1,283 @@
+#include "utils/BinaryLog.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary log decoder:
+//   log_decode [--json] FILE
+// Renders records written by Crypto::Utils::BinaryLog as text lines (the
+// Logger's own layout plus microseconds and a thread tag) or as JSON lines.
+// Concatenated streams (a file reopened by several runs) are decoded in order.
+
+namespace {
+    namespace Format = Crypto::Utils::BinaryLogFormat;
+    using json = nlohmann::json;
+
+    struct FormatInfo {
+        uint8_t level = 0;
+        std::vector<uint8_t> types;
+        std::string format;
+        std::string file;
+        uint32_t line = 0;
+    };
+
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t length) : data(data), length(length) {}
+
+        bool done() const { return position >= length; }
+        size_t offset() const { return position; }
+        bool has(size_t count) const { return length - position >= count; }
+
+        template <typename T>
+        T value() {
+            need(sizeof(T));
+            T out;
+            std::memcpy(&out, data + position, sizeof(T));
+            position += sizeof(T);
+            return out;
+        }
+
+        std::string text() {
+            uint16_t size = value<uint16_t>();
+            need(size);
+            std::string out(reinterpret_cast<const char*>(data + position), size);
+            position += size;
+            return out;
+        }
+
+        bool startsWith(const char* bytes, size_t count) const {
+            return has(count) && std::memcmp(data + position, bytes, count) == 0;
+        }
+
+        Reader sub(size_t count) {
+            need(count);
+            Reader out(data + position, count);
+            position += count;
+            return out;
+        }
+
+        void skip(size_t count) {
+            need(count);
+            position += count;
+        }
+
+    private:
+        void need(size_t count) const {
+            if (!has(count)) {
+                throw std::runtime_error("truncated record at offset " + std::to_string(position));
+            }
+        }
+
+        const uint8_t* data;
+        size_t length;
+        size_t position = 0;
+    };
+
+    const char* levelName(uint8_t level) {
+        static const char* const names[] = {"DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"};
+        return level < 5 ? names[level] : "UNKNOWN";
+    }
+
+    std::string wallClock(uint64_t nanos) {
+        std::time_t seconds = static_cast<std::time_t>(nanos / 1000000000ull);
+        std::tm local;
+        localtime_r(&seconds, &local);
+        char text[48];
+        size_t written = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+        std::snprintf(text + written, sizeof(text) - written, ".%06llu",
+                      static_cast<unsigned long long>((nanos / 1000) % 1000000));
+        return text;
+    }
+
+    // Decodes one argument into its text form (matching LogFormat) and its JSON value
+    std::string readArgument(Reader& reader, uint8_t type, json& value) {
+        switch (type) {
+            case Format::INT64: {
+                int64_t v = reader.value<int64_t>();
+                value = v;
+                return std::to_string(v);
+            }
+            case Format::UINT64: {
+                uint64_t v = reader.value<uint64_t>();
+                value = v;
+                return std::to_string(v);
+            }
+            case Format::DOUBLE: {
+                double v = reader.value<double>();
+                value = v;
+                return std::to_string(v);
+            }
+            case Format::STRING: {
+                std::string v = reader.text();
+                value = v;
+                return v;
+            }
+            case Format::BOOL: {
+                bool v = reader.value<uint8_t>() != 0;
+                value = v;
+                return v ? "true" : "false";
+            }
+            case Format::CHAR: {
+                char v = static_cast<char>(reader.value<uint8_t>());
+                value = std::string(1, v);
+                return std::string(1, v);
+            }
+            default:
+                throw std::runtime_error("unknown argument type " + std::to_string(type));
+        }
+    }
+
+    std::string render(const std::string& format, const std::vector<std::string>& args) {
+        std::string out;
+        size_t position = 0;
+        for (const std::string& arg : args) {
+            size_t placeholder = format.find("{}", position);
+            if (placeholder == std::string::npos) {
+                out.append(format, position, std::string::npos);
+                out += ' ';
+                position = format.size();
+            } else {
+                out.append(format, position, placeholder - position);
+                position = placeholder + 2;
+            }
+            out += arg;
+        }
+        out.append(format, position, std::string::npos);
+        return out;
+    }
+
+    struct Decoder {
+        bool jsonLines = false;
+        std::unordered_map<uint32_t, FormatInfo> formats;
+        uint64_t steadyOrigin = 0;
+        uint64_t systemOrigin = 0;
+
+        void header(Reader& reader) {
+            reader.skip(sizeof(Format::MAGIC));
+            steadyOrigin = reader.value<uint64_t>();
+            systemOrigin = reader.value<uint64_t>();
+            formats.clear();    // IDs are only meaningful within one stream
+        }
+
+        void format(Reader& reader) {
+            FormatInfo info;
+            uint32_t id = reader.value<uint32_t>();
+            info.level = reader.value<uint8_t>();
+            uint8_t count = reader.value<uint8_t>();
+            for (uint8_t i = 0; i < count; ++i) {
+                info.types.push_back(reader.value<uint8_t>());
+            }
+            info.format = reader.text();
+            info.file = reader.text();
+            info.line = reader.value<uint32_t>();
+            formats[id] = std::move(info);
+        }
+
+        void chunk(Reader& reader) {
+            uint32_t thread = reader.value<uint32_t>();
+            uint32_t size = reader.value<uint32_t>();
+            Reader events = reader.sub(size);
+            while (!events.done()) {
+                uint32_t id = events.value<uint32_t>();
+                uint64_t steady = events.value<uint64_t>();
+                auto found = formats.find(id);
+                if (found == formats.end()) {
+                    throw std::runtime_error("event references unknown format " + std::to_string(id));
+                }
+                const FormatInfo& info = found->second;
+
+                std::vector<std::string> args;
+                json values = json::array();
+                for (uint8_t type : info.types) {
+                    json value;
+                    args.push_back(readArgument(events, type, value));
+                    values.push_back(std::move(value));
+                }
+
+                uint64_t wall = systemOrigin + (steady - steadyOrigin);
+                std::string message = render(info.format, args);
+                if (jsonLines) {
+                    json line = {
+                        {"time", wallClock(wall)},
+                        {"ns", wall},
+                        {"level", levelName(info.level)},
+                        {"thread", thread},
+                        {"file", info.file},
+                        {"line", info.line},
+                        {"format", info.format},
+                        {"args", values},
+                        {"message", message}
+                    };
+                    std::printf("%s\n", line.dump().c_str());
+                } else {
+                    std::printf("%s [%s] (t%u) %s\n", wallClock(wall).c_str(), levelName(info.level), thread, message.c_str());
+                }
+            }
+        }
+
+        void run(Reader& reader) {
+            if (!reader.startsWith(Format::MAGIC, sizeof(Format::MAGIC))) {
+                throw std::runtime_error("not a binary log (bad magic)");
+            }
+            while (!reader.done()) {
+                if (reader.startsWith(Format::MAGIC, sizeof(Format::MAGIC))) {
+                    header(reader);
+                    continue;
+                }
+                uint8_t type = reader.value<uint8_t>();
+                if (type == Format::FORMAT) {
+                    format(reader);
+                } else if (type == Format::CHUNK) {
+                    chunk(reader);
+                } else {
+                    throw std::runtime_error("unknown record type " + std::to_string(type) + " at offset " +
+                                             std::to_string(reader.offset() - 1));
+                }
+            }
+        }
+    };
+}
+
+int main(int argc, char** argv) {
+    Decoder decoder;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            decoder.jsonLines = true;
+        } else if (path.empty()) {
+            path = argv[i];
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "usage: %s [--json] FILE\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return 1;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    try {
+        Reader reader(bytes.data(), bytes.size());
+        decoder.run(reader);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), e.what());
+        return 1;
+    }
+    return 0;
+}